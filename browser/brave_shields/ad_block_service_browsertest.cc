@@ -11,10 +11,13 @@
 
 #include "base/base64.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
+#include "base/test/bind.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -31,6 +34,7 @@
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/common/chrome_features.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "components/prefs/pref_service.h"
@@ -229,10 +233,24 @@ void AdBlockServiceTest::ShieldsDown(const GURL& url) {
   brave_shields::SetBraveShieldsEnabled(content_settings(), false, url);
 }
 
+uint64_t AdBlockServiceTest::GetAdsBlocked() {
+  // Blocked counts are written to prefs in batches, so flush the open tabs
+  // first.
+  TabStripModel* tab_strip_model = browser()->tab_strip_model();
+  for (int i = 0; i < tab_strip_model->count(); ++i) {
+    auto* observer =
+        brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+            tab_strip_model->GetWebContentsAt(i));
+    if (observer)
+      observer->FlushBlockedEventsForTesting();
+  }
+  return browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked);
+}
+
 // Load a page with an ad image, and make sure it is blocked.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByDefaultBlocker) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -242,7 +260,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByDefaultBlocker) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with an image which is not an ad, and make sure it is NOT
@@ -252,7 +270,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -262,13 +280,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('logo.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Load a page with an ad image, and make sure it is blocked by custom
 // filters.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByCustomBlocker) {
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
 
@@ -280,13 +298,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByCustomBlocker) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with an ad image, with a corresponding exception installed in
 // the custom filters, and make sure it is not blocked.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, DefaultBlockCustomException) {
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   UpdateAdBlockInstanceWithRules("*ad_banner.png");
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("@@ad_banner.png"));
@@ -299,13 +317,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, DefaultBlockCustomException) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Load a page with an image blocked by custom filters, with a corresponding
 // exception installed in the default filters, and make sure it is not blocked.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CustomBlockDefaultException) {
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   UpdateAdBlockInstanceWithRules("@@ad_banner.png");
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
@@ -318,7 +336,68 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CustomBlockDefaultException) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
+}
+
+// Make sure the list which decided whether a request is blocked is reported
+// when all of the engines are queried in one batch.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, MatchedListAttribution) {
+  UpdateAdBlockInstanceWithRules("*ad_banner.png");
+  ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
+                  ->UpdateCustomFilters(
+                      "@@||ads.example.org/ad_banner.png\n*logo.png"));
+
+  auto* ad_block_service = g_brave_browser_process->ad_block_service();
+  auto should_start_request = [ad_block_service](const std::string& spec,
+                                                 bool* did_match_rule,
+                                                 bool* did_match_exception,
+                                                 std::string* list_id) {
+    base::RunLoop run_loop;
+    ad_block_service->GetTaskRunner()->PostTaskAndReply(
+        FROM_HERE, base::BindLambdaForTesting([&]() {
+          bool did_match_important = false;
+          std::string mock_data_url;
+          ad_block_service->ShouldStartRequest(
+              GURL(spec), blink::mojom::ResourceType::kImage, "example.com",
+              did_match_rule, did_match_exception, &did_match_important,
+              &mock_data_url, list_id);
+        }),
+        run_loop.QuitClosure());
+    run_loop.Run();
+  };
+
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  std::string list_id;
+  should_start_request("https://ads.example.org/ad_banner.png", &did_match_rule,
+                       &did_match_exception, &list_id);
+  EXPECT_TRUE(did_match_rule);
+  EXPECT_TRUE(did_match_exception);
+  EXPECT_EQ(list_id, brave_shields::kCustomFiltersListId);
+
+  did_match_rule = false;
+  did_match_exception = false;
+  should_start_request("https://cdn.example.org/ad_banner.png", &did_match_rule,
+                       &did_match_exception, &list_id);
+  EXPECT_TRUE(did_match_rule);
+  EXPECT_FALSE(did_match_exception);
+  EXPECT_EQ(list_id, brave_shields::kAdBlockComponentId);
+
+  did_match_rule = false;
+  did_match_exception = false;
+  should_start_request("https://cdn.example.org/logo.png", &did_match_rule,
+                       &did_match_exception, &list_id);
+  EXPECT_TRUE(did_match_rule);
+  EXPECT_FALSE(did_match_exception);
+  EXPECT_EQ(list_id, brave_shields::kCustomFiltersListId);
+
+  did_match_rule = false;
+  did_match_exception = false;
+  should_start_request("https://cdn.example.org/photo.png", &did_match_rule,
+                       &did_match_exception, &list_id);
+  EXPECT_FALSE(did_match_rule);
+  EXPECT_FALSE(did_match_exception);
+  EXPECT_TRUE(list_id.empty());
 }
 
 // Load a page with an image which is not an ad, and make sure it is NOT
@@ -326,7 +405,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CustomBlockDefaultException) {
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        NotAdsDoNotGetBlockedByDefaultBlocker) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -336,7 +415,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('logo.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Load a page with an ad image, and make sure it is blocked by the
@@ -345,7 +424,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByRegionalBlocker) {
   g_browser_process->SetApplicationLocale("fr");
   ASSERT_STREQ(g_browser_process->GetApplicationLocale().c_str(), "fr");
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   ASSERT_TRUE(InstallRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
   ASSERT_TRUE(StartAdBlockRegionalServices());
@@ -358,7 +437,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByRegionalBlocker) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('ad_fr.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with an image which is not an ad, and make sure it is
@@ -368,7 +447,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   g_browser_process->SetApplicationLocale("fr");
   ASSERT_STREQ(g_browser_process->GetApplicationLocale().c_str(), "fr");
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   ASSERT_TRUE(InstallRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
   ASSERT_TRUE(StartAdBlockRegionalServices());
@@ -381,7 +460,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('logo.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Upgrade from v3 to v4 format data file and make sure v4-specific ad
@@ -396,7 +475,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   // expect an upgrade install
   ASSERT_TRUE(InstallDefaultAdBlockExtension("adblock-v4", 0));
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -406,14 +485,14 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('v4_specific_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with several of the same adblocked xhr requests, it should only
 // count 1.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoSameAdsGetCountedAsOne) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -429,13 +508,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoSameAdsGetCountedAsOne) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 0, 1, 2);"
                          "xhr('adbanner.js')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with different adblocked xhr requests, it should count each.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoDiffAdsGetCountedAsTwo) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -451,13 +530,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoDiffAdsGetCountedAsTwo) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 0, 1, 2);"
                          "xhr('adbanner.js?2')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
 }
 
 // New tab continues to count blocking the same resource
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -467,7 +546,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 0, 0, 1);"
                          "xhr('adbanner.js')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   ui_test_utils::NavigateToURL(browser(), url);
   contents = browser()->tab_strip_model()->GetActiveWebContents();
@@ -475,7 +554,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 0, 0, 1);"
                          "xhr('adbanner.js')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
 
   ui_test_utils::NavigateToURL(browser(), url);
 }
@@ -483,7 +562,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
 // XHRs and ads in a cross-site iframe are blocked as well.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrame) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL("a.com", "/iframe_blocking.html");
   ui_test_utils::NavigateToURL(browser(), url);
@@ -493,7 +572,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrame) {
   ASSERT_EQ(true, EvalJs(contents->GetAllFrames()[1],
                          "setExpectations(0, 0, 0, 1);"
                          "xhr('adbanner.js?1')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   // Check also an explicit request for a script since it is a common real-world
   // scenario.
@@ -508,14 +587,14 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrame) {
                            })
                          )"));
   content::RunAllTasksUntilIdle();
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
 }
 
 // Checks nothing is blocked if shields are off.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrameShieldsOff) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL url = embedded_test_server()->GetURL("a.com", "/iframe_blocking.html");
 
   brave_shields::SetBraveShieldsEnabled(content_settings(), false, url);
@@ -527,7 +606,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrameShieldsOff) {
   EXPECT_EQ(true, EvalJs(contents->GetAllFrames()[1],
                          "setExpectations(0, 0, 1, 0);"
                          "xhr('adbanner.js?1')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   // Check also an explicit request for a script since it is a common real-world
   // scenario.
@@ -542,14 +621,14 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SubFrameShieldsOff) {
                            })
                          )"));
   content::RunAllTasksUntilIdle();
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   brave_shields::ResetBraveShieldsEnabled(content_settings(), url);
 }
 
 // Requests made by a service worker should be blocked as well.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, ServiceWorkerRequest) {
   UpdateAdBlockInstanceWithRules("adbanner.js");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -560,7 +639,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, ServiceWorkerRequest) {
                          "setExpectations(0, 0, 0, 1);"
                          "installBlockingServiceWorker()"));
   // https://github.com/brave/brave-browser/issues/14087
-  // EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  // EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Load a page with an ad image which is matched on the regional blocker,
@@ -573,7 +652,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   g_browser_process->SetApplicationLocale("fr");
   ASSERT_STREQ(g_browser_process->GetApplicationLocale().c_str(), "fr");
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   ASSERT_TRUE(InstallRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
   ASSERT_TRUE(StartAdBlockRegionalServices());
@@ -585,13 +664,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   ASSERT_EQ(true, EvalJs(contents,
                          "setExpectations(1, 0, 0, 0);"
                          "addImage('ad_fr.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Make sure the third-party flag is passed into the ad-block library properly
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdBlockThirdPartyWorksByETLDP1) {
   UpdateAdBlockInstanceWithRules("||a.com$third-party");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL tab_url = embedded_test_server()->GetURL("test.a.com", kAdBlockTestPage);
   GURL resource_url =
@@ -603,14 +682,14 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdBlockThirdPartyWorksByETLDP1) {
             EvalJs(contents, base::StringPrintf("setExpectations(1, 0, 0, 0);"
                                                 "addImage('%s')",
                                                 resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Make sure the third-party flag is passed into the ad-block library properly
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        AdBlockThirdPartyWorksForThirdPartyHost) {
   UpdateAdBlockInstanceWithRules("||a.com$third-party");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("b.com", kAdBlockTestPage);
   GURL resource_url = embedded_test_server()->GetURL("a.com", "/logo.png");
   ui_test_utils::NavigateToURL(browser(), tab_url);
@@ -620,7 +699,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
             EvalJs(contents, base::StringPrintf("setExpectations(0, 1, 0, 0);"
                                                 "addImage('%s')",
                                                 resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // These tests fail intermittently on macOS; see
@@ -641,7 +720,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        MAYBE_CnameCloakedRequestsGetBlocked) {
   UpdateAdBlockInstanceWithRules("||cname-cloak-endpoint.tracking.com^");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("a.com", kAdBlockTestPage);
   GURL direct_resource_url =
       embedded_test_server()->GetURL("a83idbka2e.a.com", "/logo.png");
@@ -684,7 +763,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                        "setExpectations(0, 1, 0, 0);"
                                        "addImage('%s')",
                                        direct_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
   // Note one resolution for the root document
   ASSERT_EQ(2ULL, inner_resolver->num_resolve());
 
@@ -695,7 +774,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                        "setExpectations(0, 1, 0, 1);"
                                        "xhr('%s')",
                                        chain_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
   ASSERT_EQ(3ULL, inner_resolver->num_resolve());
 
   // XHR request to an unblocked first-party endpoint that is CNAME cloaked.
@@ -704,7 +783,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                          base::StringPrintf("setExpectations(0, 1, 1, 1);"
                                             "xhr('%s')",
                                             safe_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
   ASSERT_EQ(4ULL, inner_resolver->num_resolve());
 
   // XHR request directly to a blocked third-party endpoint.
@@ -713,7 +792,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                          base::StringPrintf("setExpectations(0, 1, 1, 2);"
                                             "xhr('%s')",
                                             bad_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 3ULL);
+  EXPECT_EQ(GetAdsBlocked(), 3ULL);
   ASSERT_EQ(4ULL, inner_resolver->num_resolve());
 
   // Unset the host resolver so as not to interfere with later tests.
@@ -727,7 +806,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   UpdateAdBlockInstanceWithRules(
       "||cname-cloak-endpoint.tracking.com^\n"
       "@@||a.com/logo-unblock.png|");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("a.com", kAdBlockTestPage);
   GURL direct_resource_url =
       embedded_test_server()->GetURL("a83idbka2e.a.com", "/logo.png");
@@ -770,7 +849,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                        "setExpectations(0, 1, 0, 0);"
                                        "addImage('%s')",
                                        direct_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
   // Note one resolution for the root document
   ASSERT_EQ(2ULL, inner_resolver->num_resolve());
 
@@ -781,7 +860,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                                        "setExpectations(0, 1, 0, 1);"
                                        "xhr('%s')",
                                        chain_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
   ASSERT_EQ(3ULL, inner_resolver->num_resolve());
 
   // XHR request to an unblocked first-party endpoint that is CNAME cloaked.
@@ -790,7 +869,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                          base::StringPrintf("setExpectations(0, 1, 1, 1);"
                                             "xhr('%s')",
                                             safe_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+  EXPECT_EQ(GetAdsBlocked(), 2ULL);
   ASSERT_EQ(4ULL, inner_resolver->num_resolve());
 
   // XHR request directly to a blocked third-party endpoint.
@@ -799,7 +878,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                          base::StringPrintf("setExpectations(0, 1, 1, 2);"
                                             "xhr('%s')",
                                             bad_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 3ULL);
+  EXPECT_EQ(GetAdsBlocked(), 3ULL);
   ASSERT_EQ(4ULL, inner_resolver->num_resolve());
 
   // Unset the host resolver so as not to interfere with later tests.
@@ -820,7 +899,7 @@ class CnameUncloakingFlagDisabledTest : public AdBlockServiceTest {
 // flag is disabled.
 IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
   UpdateAdBlockInstanceWithRules("||cname-cloak-endpoint.tracking.com^");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("a.com", kAdBlockTestPage);
   GURL direct_resource_url =
       embedded_test_server()->GetURL("a83idbka2e.a.com", "/logo.png");
@@ -862,7 +941,7 @@ IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
                                        "setExpectations(1, 0, 0, 0);"
                                        "addImage('%s')",
                                        direct_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   // Note one resolution for the root document
   ASSERT_EQ(0ULL, inner_resolver->num_resolve());
 
@@ -872,7 +951,7 @@ IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
                                        "setExpectations(2, 0, 0, 0);"
                                        "addImage('%s')",
                                        chain_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   ASSERT_EQ(0ULL, inner_resolver->num_resolve());
 
   // XHR request to an unblocked first-party endpoint that is CNAME cloaked.
@@ -881,7 +960,7 @@ IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
                          base::StringPrintf("setExpectations(2, 0, 1, 0);"
                                             "xhr('%s')",
                                             safe_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   ASSERT_EQ(0ULL, inner_resolver->num_resolve());
 
   // XHR request directly to a blocked third-party endpoint. It should be
@@ -890,7 +969,7 @@ IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
                          base::StringPrintf("setExpectations(2, 0, 1, 1);"
                                             "xhr('%s')",
                                             bad_resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
   ASSERT_EQ(0ULL, inner_resolver->num_resolve());
 
   // Unset the host resolver so as not to interfere with later tests.
@@ -900,7 +979,7 @@ IN_PROC_BROWSER_TEST_F(CnameUncloakingFlagDisabledTest, NoDnsQueriesIssued) {
 // Load an image from a specific subdomain, and make sure it is blocked.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, BlockNYP) {
   UpdateAdBlockInstanceWithRules("||sp1.nypost.com$third-party");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("b.com", kAdBlockTestPage);
   GURL resource_url =
       embedded_test_server()->GetURL("sp1.nypost.com", "/logo.png");
@@ -911,13 +990,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, BlockNYP) {
             EvalJs(contents, base::StringPrintf("setExpectations(0, 1, 0, 0);"
                                                 "addImage('%s')",
                                                 resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Frame root URL is used for context rather than the tab URL
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, FrameSourceURL) {
   UpdateAdBlockInstanceWithRules("adbanner.js$domain=a.com");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL url = embedded_test_server()->GetURL("a.com", "/iframe_blocking.html");
   ui_test_utils::NavigateToURL(browser(), url);
   content::WebContents* contents =
@@ -926,7 +1005,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, FrameSourceURL) {
   ASSERT_EQ(true, EvalJs(contents->GetAllFrames()[1],
                          "setExpectations(0, 0, 1, 0);"
                          "xhr('adbanner.js?1')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   UpdateAdBlockInstanceWithRules("adbanner.js$domain=b.com");
   ui_test_utils::NavigateToURL(browser(), url);
@@ -935,7 +1014,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, FrameSourceURL) {
   ASSERT_EQ(true, EvalJs(contents->GetAllFrames()[1],
                          "setExpectations(0, 0, 0, 1);"
                          "xhr('adbanner.js?1')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Tags for social buttons work
@@ -944,7 +1023,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBlockTagTest) {
       base::StringPrintf("||example.com^$tag=%s",
                          brave_shields::kFacebookEmbeds)
           .c_str());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("b.com", kAdBlockTestPage);
   g_brave_browser_process->ad_block_service()->EnableTag(
       brave_shields::kFacebookEmbeds, true);
@@ -958,13 +1037,13 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBlockTagTest) {
             EvalJs(contents, base::StringPrintf("setExpectations(0, 1, 0, 0);"
                                                 "addImage('%s')",
                                                 resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Lack of tags for social buttons work
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBlockDiffTagTest) {
   UpdateAdBlockInstanceWithRules("||example.com^$tag=sup");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
   GURL tab_url = embedded_test_server()->GetURL("b.com", kAdBlockTestPage);
   g_brave_browser_process->ad_block_service()->EnableTag(
       brave_shields::kFacebookEmbeds, true);
@@ -978,7 +1057,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SocialButttonAdBlockDiffTagTest) {
             EvalJs(contents, base::StringPrintf("setExpectations(1, 0, 0, 0);"
                                                 "addImage('%s')",
                                                 resource_url.spec().c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Tags are preserved after resetting
@@ -1041,7 +1120,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TagPrefsControlTags) {
 // Load a page with a blocked image, and make sure it is collapsed.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CollapseBlockedImage) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -1051,7 +1130,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CollapseBlockedImage) {
   EXPECT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   // There is no way for JS to directly tell if an element has been collapsed,
   // but the clientHeight property is zero for collapsed elements and nonzero
@@ -1064,7 +1143,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CollapseBlockedImage) {
 // Load a page with a blocked iframe, and make sure it is collapsed.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CollapseBlockedIframe) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -1072,7 +1151,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CollapseBlockedIframe) {
       browser()->tab_strip_model()->GetActiveWebContents();
 
   EXPECT_EQ(true, EvalJs(contents, "addFrame('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   // There is no way for JS to directly tell if an element has been collapsed,
   // but the clientHeight property is zero for collapsed elements and nonzero
@@ -1096,7 +1175,7 @@ class CollapseBlockedElementsFlagDisabledTest : public AdBlockServiceTest {
 IN_PROC_BROWSER_TEST_F(CollapseBlockedElementsFlagDisabledTest,
                        DontCollapseBlockedImage) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -1106,7 +1185,7 @@ IN_PROC_BROWSER_TEST_F(CollapseBlockedElementsFlagDisabledTest,
   EXPECT_EQ(true, EvalJs(contents,
                          "setExpectations(0, 1, 0, 0);"
                          "addImage('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   // There is no way for JS to directly tell if an element has been collapsed,
   // but the clientHeight property is zero for collapsed elements and nonzero
@@ -1120,7 +1199,7 @@ IN_PROC_BROWSER_TEST_F(CollapseBlockedElementsFlagDisabledTest,
 IN_PROC_BROWSER_TEST_F(CollapseBlockedElementsFlagDisabledTest,
                        DontCollapseBlockedIframe) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -1128,7 +1207,7 @@ IN_PROC_BROWSER_TEST_F(CollapseBlockedElementsFlagDisabledTest,
       browser()->tab_strip_model()->GetActiveWebContents();
 
   EXPECT_EQ(true, EvalJs(contents, "addFrame('ad_banner.png')"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 
   // There is no way for JS to directly tell if an element has been collapsed,
   // but the clientHeight property is zero for collapsed elements and nonzero
@@ -1152,7 +1231,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, RedirectRulesAreRespected) {
           "content": "KGZ1bmN0aW9uKCkgewogICAgJ3VzZSBzdHJpY3QnOwp9KSgpOwo="
         }
       ])");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   const GURL url =
       embedded_test_server()->GetURL("example.com", kAdBlockTestPage);
@@ -1168,7 +1247,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, RedirectRulesAreRespected) {
                                  "setExpectations(0, 0, 1, 0);"
                                  "xhr_expect_content('%s', '%s');",
                                  resource_url.spec().c_str(), noopjs.c_str())));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(GetAdsBlocked(), 1ULL);
 }
 
 // Verify that scripts violating a Content Security Policy from a `$csp` rule
@@ -1176,7 +1255,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, RedirectRulesAreRespected) {
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRule) {
   UpdateAdBlockInstanceWithRules(
       "||example.com^$csp=script-src 'nonce-abcdef' 'unsafe-eval' 'self'");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   const GURL url =
       embedded_test_server()->GetURL("example.com", "/csp_rules.html");
@@ -1193,7 +1272,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRule) {
   EXPECT_EQ(true, EvalJs(contents, "!!window.loadedDataImage"));
 
   // Violations of injected CSP directives do not increment the Shields counter
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Verify that Content Security Policies from multiple `$csp` rules are
@@ -1209,7 +1288,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleMerging) {
                       "||example.com^$csp=img-src 'none'\n"
                       "||sub.example.com^$csp=script-src 'nonce-abcdef' "
                       "'unsafe-eval' 'unsafe-inline'"));
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   const GURL url =
       embedded_test_server()->GetURL("sub.example.com", "/csp_rules.html");
@@ -1226,7 +1305,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleMerging) {
   EXPECT_EQ(false, EvalJs(contents, "!!window.loadedDataImage"));
 
   // Violations of injected CSP directives do not increment the Shields counter
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 // Verify that scripts violating a Content Security Policy from a `$csp` rule
@@ -1234,7 +1313,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleMerging) {
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleShieldsDown) {
   UpdateAdBlockInstanceWithRules(
       "||example.com^$csp=script-src 'nonce-abcdef' 'unsafe-eval' 'self'");
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 
   const GURL url =
       embedded_test_server()->GetURL("example.com", "/csp_rules.html");
@@ -1252,7 +1331,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleShieldsDown) {
   EXPECT_EQ(true, EvalJs(contents, "!!window.loadedUnsafeInlineScript"));
   EXPECT_EQ(true, EvalJs(contents, "!!window.loadedDataImage"));
 
-  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  EXPECT_EQ(GetAdsBlocked(), 0ULL);
 }
 
 class CosmeticFilteringFlagDisabledTest : public AdBlockServiceTest {
@@ -6,6 +6,7 @@
 #ifndef BRAVE_BROWSER_BRAVE_SHIELDS_AD_BLOCK_SERVICE_BROWSERTEST_H_
 #define BRAVE_BROWSER_BRAVE_SHIELDS_AD_BLOCK_SERVICE_BROWSERTEST_H_
 
+#include <cstdint>
 #include <string>
 
 #include "chrome/browser/extensions/extension_browsertest.h"
@@ -38,6 +39,8 @@ class AdBlockServiceTest : public extensions::ExtensionBrowserTest {
   void WaitForAdBlockServiceThreads();
   void WaitForBraveExtensionShieldsDataReady();
   void ShieldsDown(const GURL& url);
+  // Returns the ads blocked count after flushing the counts held by tabs.
+  uint64_t GetAdsBlocked();
 };
 
 #endif  // BRAVE_BROWSER_BRAVE_SHIELDS_AD_BLOCK_SERVICE_BROWSERTEST_H_
@@ -5,11 +5,13 @@
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/buildflags.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -50,6 +52,9 @@ using content::WebContents;
 
 namespace {
 
+constexpr base::TimeDelta kFlushBlockedEventsInterval =
+    base::TimeDelta::FromMilliseconds(500);
+
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
 // if this is fixed by running the following test: npm run test --
@@ -76,6 +81,20 @@ void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
   }
 }
 
+// Returns the stats pref counting blocks of |block_type|, or nullptr if
+// |block_type| isn't counted.
+const char* GetBlockedCountPrefName(const std::string& block_type) {
+  if (block_type == brave_shields::kAds)
+    return kAdsBlocked;
+  if (block_type == brave_shields::kHTTPUpgradableResources)
+    return kHttpsUpgrades;
+  if (block_type == brave_shields::kJavaScript)
+    return kJavascriptBlocked;
+  if (block_type == brave_shields::kFingerprintingV2)
+    return kFingerprintingBlocked;
+  return nullptr;
+}
+
 }  // namespace
 
 namespace brave_shields {
@@ -118,12 +137,47 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+  return blocked_url_paths_.count(std::hash<std::string>()(subresource));
 }
 
 void BraveShieldsWebContentsObserver::AddBlockedSubresource(
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  blocked_url_paths_.insert(std::hash<std::string>()(subresource));
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEventsForTesting() {
+  FlushBlockedEvents();
+}
+
+void BraveShieldsWebContentsObserver::AddBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_events_.emplace_back(block_type, subresource);
+  if (!flush_blocked_events_timer_.IsRunning()) {
+    flush_blocked_events_timer_.Start(
+        FROM_HERE, kFlushBlockedEventsInterval, this,
+        &BraveShieldsWebContentsObserver::FlushBlockedEvents);
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  flush_blocked_events_timer_.Stop();
+
+  std::vector<std::pair<std::string, std::string>> events;
+  events.swap(pending_blocked_events_);
+  for (const auto& event : events)
+    DispatchBlockedEventForWebContents(event.first, event.second,
+                                       web_contents());
+
+  if (pending_blocked_counts_.empty())
+    return;
+  PrefService* prefs =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+          ->GetOriginalProfile()
+          ->GetPrefs();
+  for (const auto& count : pending_blocked_counts_)
+    prefs->SetUint64(count.first, prefs->GetUint64(count.first) + count.second);
+  pending_blocked_counts_.clear();
 }
 
 // static
@@ -133,37 +187,26 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     const std::string& block_type) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  auto subresource = request_url.spec();
+  const std::string& subresource = request_url.spec();
   WebContents* web_contents =
       WebContents::FromFrameTreeNodeId(frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
-
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer && !observer->IsBlockedSubresource(subresource)) {
+  BraveShieldsWebContentsObserver* observer =
+      web_contents
+          ? BraveShieldsWebContentsObserver::FromWebContents(web_contents)
+          : nullptr;
+  if (observer) {
+    observer->AddBlockedEvent(block_type, subresource);
+    if (!observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
-      PrefService* prefs =
-          Profile::FromBrowserContext(web_contents->GetBrowserContext())
-              ->GetOriginalProfile()
-              ->GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-                         prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-                         prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
+      if (const char* pref_name = GetBlockedCountPrefName(block_type))
+        ++observer->pending_blocked_counts_[pref_name];
     }
+  } else {
+    DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
   }
 #if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
   brave_perf_predictor::PerfPredictorTabHelper::DispatchBlockedEvent(
-      request_url.spec(), frame_tree_node_id);
+      subresource, frame_tree_node_id);
 #endif
 }
 
@@ -201,8 +244,7 @@ void BraveShieldsWebContentsObserver::OnJavaScriptBlocked(
   if (!web_contents)
     return;
 
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-                                     base::UTF16ToUTF8(details), web_contents);
+  AddBlockedEvent(brave_shields::kJavaScript, base::UTF16ToUTF8(details));
 }
 
 // static
@@ -221,6 +263,8 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    // Report what the previous page blocked before the shields panel resets.
+    FlushBlockedEvents();
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
@@ -240,6 +284,10 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   }
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedEvents();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins,
     WebContents* contents) {
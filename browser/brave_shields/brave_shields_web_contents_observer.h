@@ -7,13 +7,15 @@
 #define BRAVE_BROWSER_BRAVE_SHIELDS_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
-#include <set>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_receiver_set.h"
@@ -48,6 +50,9 @@ class BraveShieldsWebContentsObserver
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Writes the blocked counts to prefs and dispatches the blocked events held
+  // for this tab without waiting for the next flush.
+  void FlushBlockedEventsForTesting();
 
  protected:
   // content::WebContentsObserver overrides.
@@ -57,6 +62,7 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
@@ -73,10 +79,24 @@ class BraveShieldsWebContentsObserver
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
   GetBraveShieldsRemote(content::RenderFrameHost* rfh);
 
+  // Holds the blocked event until the next flush.
+  void AddBlockedEvent(const std::string& block_type,
+                       const std::string& subresource);
+  void FlushBlockedEvents();
+
   std::vector<std::string> allowed_script_origins_;
-  // We keep a set of the current page's blocked URLs in case the page
-  // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  // We keep a set of hashes of the current page's blocked URLs in case the
+  // page continually tries to load the same blocked URLs.
+  std::unordered_set<size_t> blocked_url_paths_;
+
+  // Blocked resources are reported in batches, as a page can block hundreds
+  // of them while loading. These hold the blocked counts, keyed by stats pref
+  // name, and the (block type, subresource) events not yet reported. They are
+  // flushed by |flush_blocked_events_timer_|, before a new page commits and
+  // when the tab is destroyed.
+  base::flat_map<const char*, uint64_t> pending_blocked_counts_;
+  std::vector<std::pair<std::string, std::string>> pending_blocked_events_;
+  base::OneShotTimer flush_blocked_events_timer_;
 
   content::WebContentsFrameReceiverSet<brave_shields::mojom::BraveShieldsHost>
       brave_shields_receivers_;
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+
+#include <string>
+
+#include "base/time/time.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+constexpr char kAdUrl[] = "https://ads.example.com/ad_banner.png";
+constexpr char kOtherAdUrl[] = "https://ads.example.com/other_banner.png";
+constexpr char kTrackerUrl[] = "https://tracker.example.com/analytics.js";
+}  // namespace
+
+class BraveShieldsWebContentsObserverTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  BraveShieldsWebContentsObserverTest()
+      : ChromeRenderViewHostTestHarness(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+  ~BraveShieldsWebContentsObserverTest() override = default;
+  BraveShieldsWebContentsObserverTest(
+      const BraveShieldsWebContentsObserverTest&) = delete;
+  BraveShieldsWebContentsObserverTest& operator=(
+      const BraveShieldsWebContentsObserverTest&) = delete;
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    NavigateAndCommit(GURL("https://brave.com"));
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+  }
+
+  void DispatchBlockedEvent(const std::string& url,
+                            const std::string& block_type) {
+    BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+        GURL(url), web_contents()->GetMainFrame()->GetFrameTreeNodeId(),
+        block_type);
+  }
+
+  uint64_t GetCount(const char* pref_name) {
+    return profile()->GetPrefs()->GetUint64(pref_name);
+  }
+
+  BraveShieldsWebContentsObserver* observer() {
+    return BraveShieldsWebContentsObserver::FromWebContents(web_contents());
+  }
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, WriteCountsInBatches) {
+  DispatchBlockedEvent(kAdUrl, kAds);
+  DispatchBlockedEvent(kOtherAdUrl, kAds);
+  EXPECT_EQ(0ULL, GetCount(kAdsBlocked));
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(500));
+  EXPECT_EQ(2ULL, GetCount(kAdsBlocked));
+
+  DispatchBlockedEvent(kTrackerUrl, kAds);
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(500));
+  EXPECT_EQ(3ULL, GetCount(kAdsBlocked));
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, CountBlockedUrlOnce) {
+  DispatchBlockedEvent(kAdUrl, kAds);
+  DispatchBlockedEvent(kAdUrl, kAds);
+  DispatchBlockedEvent(kOtherAdUrl, kAds);
+  DispatchBlockedEvent(kAdUrl, kAds);
+  observer()->FlushBlockedEventsForTesting();
+
+  EXPECT_EQ(2ULL, GetCount(kAdsBlocked));
+  EXPECT_TRUE(observer()->IsBlockedSubresource(kAdUrl));
+  EXPECT_TRUE(observer()->IsBlockedSubresource(kOtherAdUrl));
+  EXPECT_FALSE(observer()->IsBlockedSubresource(kTrackerUrl));
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, CountEachBlockType) {
+  DispatchBlockedEvent(kAdUrl, kAds);
+  DispatchBlockedEvent(kOtherAdUrl, kHTTPUpgradableResources);
+  DispatchBlockedEvent(kTrackerUrl, kJavaScript);
+  DispatchBlockedEvent("https://example.com/canvas.js", kFingerprintingV2);
+  observer()->FlushBlockedEventsForTesting();
+
+  EXPECT_EQ(1ULL, GetCount(kAdsBlocked));
+  EXPECT_EQ(1ULL, GetCount(kHttpsUpgrades));
+  EXPECT_EQ(1ULL, GetCount(kJavascriptBlocked));
+  EXPECT_EQ(1ULL, GetCount(kFingerprintingBlocked));
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, WriteCountsWhenTabIsDestroyed) {
+  DispatchBlockedEvent(kAdUrl, kAds);
+  EXPECT_EQ(0ULL, GetCount(kAdsBlocked));
+
+  DeleteContents();
+  EXPECT_EQ(1ULL, GetCount(kAdsBlocked));
+}
+
+}  // namespace brave_shields
@@ -21,6 +21,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/api/tabs/tabs_constants.h"
@@ -45,6 +46,34 @@ namespace {
 const char kInvalidUrlError[] = "Invalid URL.";
 const char kInvalidControlTypeError[] = "Invalid ControlType.";
 
+base::Value StringsToValue(std::vector<std::string> strings) {
+  base::Value list(base::Value::Type::LIST);
+  for (std::string& string : strings)
+    list.Append(std::move(string));
+  return list;
+}
+
+// Builds the dictionary that the cosmetic filters content script expects.
+base::Value UrlSpecificResourcesToValue(
+    cosmetic_filters::mojom::UrlSpecificResourcesPtr resources) {
+  base::Value style_selectors(base::Value::Type::DICTIONARY);
+  for (auto& style_selector : resources->style_selectors) {
+    style_selectors.SetKey(style_selector.first,
+                           StringsToValue(std::move(style_selector.second)));
+  }
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("hide_selectors",
+               StringsToValue(std::move(resources->hide_selectors)));
+  value.SetKey("force_hide_selectors",
+               StringsToValue(std::move(resources->force_hide_selectors)));
+  value.SetKey("style_selectors", std::move(style_selectors));
+  value.SetKey("exceptions", StringsToValue(std::move(resources->exceptions)));
+  value.SetStringKey("injected_script", resources->injected_script);
+  value.SetBoolKey("generichide", resources->generichide);
+  return value;
+}
+
 }  // namespace
 
 ExtensionFunction::ResponseAction
@@ -68,15 +97,15 @@ BraveShieldsUrlCosmeticResourcesFunction::Run() {
 std::unique_ptr<base::ListValue>
 BraveShieldsUrlCosmeticResourcesFunction::GetUrlCosmeticResourcesOnTaskRunner(
     const std::string& url) {
-  absl::optional<base::Value> resources =
+  cosmetic_filters::mojom::UrlSpecificResourcesPtr resources =
       g_brave_browser_process->ad_block_service()->UrlCosmeticResources(url);
 
-  if (!resources || !resources->is_dict()) {
+  if (!resources) {
     return std::unique_ptr<base::ListValue>();
   }
 
   auto result_list = std::make_unique<base::ListValue>();
-  result_list->Append(std::move(*resources));
+  result_list->Append(UrlSpecificResourcesToValue(std::move(resources)));
   return result_list;
 }
 
@@ -113,16 +142,14 @@ std::unique_ptr<base::ListValue> BraveShieldsHiddenClassIdSelectorsFunction::
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  absl::optional<base::Value> hide_selectors =
-      g_brave_browser_process->ad_block_service()->HiddenClassIdSelectors(
-          classes, ids, exceptions);
-
-  if (!hide_selectors || !hide_selectors->is_list())
-    return std::make_unique<base::ListValue>();
-
-  auto result_list =
-      std::make_unique<base::ListValue>(hide_selectors->GetList());
+  std::vector<std::string> hide_selectors;
+  std::vector<std::string> force_hide_selectors;
+  g_brave_browser_process->ad_block_service()->HiddenClassIdSelectors(
+      classes, ids, exceptions, &hide_selectors, &force_hide_selectors);
 
+  auto result_list = std::make_unique<base::ListValue>();
+  result_list->Append(StringsToValue(std::move(hide_selectors)));
+  result_list->Append(StringsToValue(std::move(force_hide_selectors)));
   return result_list;
 }
 
@@ -6,6 +6,7 @@
 #include "base/path_service.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/thread_test_helper.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/extensions/brave_extension_functional_test.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -70,6 +71,9 @@ IN_PROC_BROWSER_TEST_F(BraveExtensionProviderTest,
       "addImage('ad_banner.png')",
       &as_expected));
   EXPECT_TRUE(as_expected);
+  // Blocked counts are written to prefs in batches.
+  brave_shields::BraveShieldsWebContentsObserver::FromWebContents(contents)
+      ->FlushBlockedEventsForTesting();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -3,7 +3,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <map>
+#include <memory>
+#include <string>
+
 #include "base/containers/flat_map.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/scoped_observation.h"
@@ -24,13 +29,17 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/browser/extension_registry_observer.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
 using brave_rewards::RewardsService;
 using brave_rewards::RewardsServiceFactory;
 using extensions::ExtensionBrowserTest;
+using extensions::ExtensionRegistry;
 using greaselion::GreaselionDownloadService;
+using greaselion::GreaselionRule;
 using greaselion::GreaselionService;
 using greaselion::GreaselionServiceFactory;
 
@@ -93,6 +102,32 @@ class GreaselionServiceWaiter : public GreaselionService::Observer {
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceWaiter);
 };
 
+class ExtensionUnloadCounter : public extensions::ExtensionRegistryObserver {
+ public:
+  explicit ExtensionUnloadCounter(ExtensionRegistry* extension_registry) {
+    scoped_observer_.Observe(extension_registry);
+  }
+  ~ExtensionUnloadCounter() override = default;
+
+  int count() const { return count_; }
+
+ private:
+  // extensions::ExtensionRegistryObserver:
+  void OnExtensionUnloaded(
+      content::BrowserContext* browser_context,
+      const extensions::Extension* extension,
+      extensions::UnloadedExtensionReason reason) override {
+    count_++;
+  }
+
+  int count_ = 0;
+  base::ScopedObservation<ExtensionRegistry,
+                          extensions::ExtensionRegistryObserver>
+      scoped_observer_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ExtensionUnloadCounter);
+};
+
 class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
  public:
   GreaselionServiceTest(): https_server_(net::EmbeddedTestServer::TYPE_HTTPS) {
@@ -140,6 +175,33 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
 
+  GreaselionService* greaselion_service() {
+    return GreaselionServiceFactory::GetForBrowserContext(profile());
+  }
+
+  void SetFeatureEnabledAndWait(greaselion::GreaselionFeature feature,
+                                bool enabled) {
+    GreaselionServiceWaiter waiter(greaselion_service());
+    greaselion_service()->SetFeatureEnabled(feature, enabled);
+    waiter.Wait();
+  }
+
+  void UpdateInstalledExtensionsAndWait() {
+    GreaselionServiceWaiter waiter(greaselion_service());
+    greaselion_service()->UpdateInstalledExtensions();
+    waiter.Wait();
+  }
+
+  // Returns the loaded Greaselion extensions by id
+  std::map<std::string, const extensions::Extension*>
+  GetGreaselionExtensions() {
+    std::map<std::string, const extensions::Extension*> extensions;
+    ExtensionRegistry* registry = ExtensionRegistry::Get(profile());
+    for (const auto& id : greaselion_service()->GetExtensionIdsForTesting())
+      extensions[id] = registry->enabled_extensions().GetByID(id);
+    return extensions;
+  }
+
   void StartRewards() {
     // HTTP resolver
     https_server_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
@@ -366,6 +428,109 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   EXPECT_FALSE(greaselion_service->IsGreaselionExtension("INVALID"));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       ToggleFeatureKeepsUnrelatedExtensionsLoaded) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  const auto extensions = GetGreaselionExtensions();
+  ExtensionUnloadCounter unload_counter(ExtensionRegistry::Get(profile()));
+
+  // Enabling auto-contribute installs the rule with that precondition only
+  SetFeatureEnabledAndWait(greaselion::AUTO_CONTRIBUTION, true);
+  const auto enabled_extensions = GetGreaselionExtensions();
+  EXPECT_EQ(0, unload_counter.count());
+  ASSERT_EQ(extensions.size() + 1, enabled_extensions.size());
+  for (const auto& extension : extensions) {
+    auto it = enabled_extensions.find(extension.first);
+    ASSERT_NE(it, enabled_extensions.end());
+    EXPECT_EQ(extension.second, it->second);
+  }
+
+  // Disabling it again only unloads that extension
+  SetFeatureEnabledAndWait(greaselion::AUTO_CONTRIBUTION, false);
+  EXPECT_EQ(1, unload_counter.count());
+  EXPECT_EQ(extensions, GetGreaselionExtensions());
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ReinstallChangedRule) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  // Change the script of the only rule that uses it
+  const GreaselionRule* changed_rule = nullptr;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *g_brave_browser_process->greaselion_download_service()->rules()) {
+    if (!rule->messages().empty())
+      changed_rule = rule.get();
+  }
+  ASSERT_TRUE(changed_rule);
+  ASSERT_EQ(1UL, changed_rule->scripts().size());
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    const std::string script = "document.title = 'Changed';";
+    ASSERT_TRUE(base::WriteFile(changed_rule->scripts()[0], script));
+  }
+
+  const auto extensions = GetGreaselionExtensions();
+  ExtensionUnloadCounter unload_counter(ExtensionRegistry::Get(profile()));
+
+  UpdateInstalledExtensionsAndWait();
+
+  // Extension ids are derived from the rule name, so only the changed
+  // extension is a new object
+  const auto updated_extensions = GetGreaselionExtensions();
+  EXPECT_EQ(1, unload_counter.count());
+  ASSERT_EQ(extensions.size(), updated_extensions.size());
+  int changed_extensions = 0;
+  for (const auto& extension : extensions) {
+    auto it = updated_extensions.find(extension.first);
+    ASSERT_NE(it, updated_extensions.end());
+    if (extension.second != it->second)
+      changed_extensions++;
+  }
+  EXPECT_EQ(1, changed_extensions);
+
+  const GURL url =
+      embedded_test_server()->GetURL("messages.example.com", "/simple.html");
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::WaitForLoadStop(contents));
+  std::string title;
+  ASSERT_TRUE(
+      ExecuteScriptAndExtractString(contents,
+                                    "window.domAutomationController.send("
+                                    "document.title)",
+                                    &title));
+  EXPECT_EQ(title, "Changed");
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ReenableFeatureReusesExtension) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  const auto extensions = GetGreaselionExtensions();
+
+  SetFeatureEnabledAndWait(greaselion::AUTO_CONTRIBUTION, true);
+  auto enabled_extensions = GetGreaselionExtensions();
+  ASSERT_EQ(extensions.size() + 1, enabled_extensions.size());
+  std::string id;
+  const extensions::Extension* extension = nullptr;
+  for (const auto& enabled_extension : enabled_extensions) {
+    if (!extensions.count(enabled_extension.first)) {
+      id = enabled_extension.first;
+      extension = enabled_extension.second;
+    }
+  }
+  ASSERT_TRUE(extension);
+
+  SetFeatureEnabledAndWait(greaselion::AUTO_CONTRIBUTION, false);
+  EXPECT_FALSE(greaselion_service()->IsGreaselionExtension(id));
+
+  // The cached conversion is installed again rather than converting the rule
+  SetFeatureEnabledAndWait(greaselion::AUTO_CONTRIBUTION, true);
+  enabled_extensions = GetGreaselionExtensions();
+  ASSERT_TRUE(enabled_extensions.count(id));
+  EXPECT_EQ(extension, enabled_extensions[id]);
+}
 
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
                       ScriptInjectionWithBrowserVersionConditionLowWild) {
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_shields_settings_cache.h"
+
+#include "base/memory/ptr_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave {
+
+namespace {
+
+// User data key for BraveShieldsSettingsCache.
+const void* const kBraveShieldsSettingsCacheUserDataKey =
+    &kBraveShieldsSettingsCacheUserDataKey;
+
+constexpr size_t kMaxCachedOrigins = 100;
+
+}  // namespace
+
+BraveShieldsSettingsCache::BraveShieldsSettingsCache(
+    HostContentSettingsMap* map)
+    : map_(map), settings_(kMaxCachedOrigins) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  map_->AddObserver(this);
+}
+
+BraveShieldsSettingsCache::~BraveShieldsSettingsCache() {
+  map_->RemoveObserver(this);
+}
+
+// static
+BraveShieldsSettingsCache* BraveShieldsSettingsCache::GetForBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto* self = static_cast<BraveShieldsSettingsCache*>(
+      browser_context->GetUserData(kBraveShieldsSettingsCacheUserDataKey));
+  if (!self) {
+    self = new BraveShieldsSettingsCache(
+        HostContentSettingsMapFactory::GetForProfile(
+            Profile::FromBrowserContext(browser_context)));
+    browser_context->SetUserData(kBraveShieldsSettingsCacheUserDataKey,
+                                 base::WrapUnique(self));
+  }
+
+  return self;
+}
+
+ShieldsSettings BraveShieldsSettingsCache::GetSettings(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto it = settings_.Get(url);
+  if (it != settings_.end())
+    return it->second;
+
+  HostContentSettingsMap* map = map_.get();
+  ShieldsSettings settings;
+  settings.brave_shields_enabled =
+      brave_shields::GetBraveShieldsEnabled(map, url);
+  settings.allow_ads = brave_shields::GetAdControlType(map, url) ==
+                       brave_shields::ControlType::ALLOW;
+  settings.https_everywhere_enabled =
+      brave_shields::GetHTTPSEverywhereEnabled(map, url);
+  settings.allow_referrers = brave_shields::AllowReferrers(map, url);
+
+  settings_.Put(url, settings);
+  return settings;
+}
+
+void BraveShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  settings_.Clear();
+}
+
+}  // namespace brave
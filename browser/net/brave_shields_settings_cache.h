@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_BROWSER_NET_BRAVE_SHIELDS_SETTINGS_CACHE_H_
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/supports_user_data.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace content {
+class BrowserContext;
+}
+
+namespace brave {
+
+// Shields settings that apply to requests made by a page.
+struct ShieldsSettings {
+  bool brave_shields_enabled = true;
+  bool allow_ads = false;
+  bool https_everywhere_enabled = true;
+  bool allow_referrers = false;
+};
+
+// Caches the resolved shields settings per tab origin so subresource requests
+// don't pattern match the content settings rules again. There is one
+// |BraveShieldsSettingsCache| per profile and it is cleared whenever a content
+// setting changes. Only used on the UI thread.
+class BraveShieldsSettingsCache : public base::SupportsUserData::Data,
+                                  public content_settings::Observer {
+ public:
+  ~BraveShieldsSettingsCache() override;
+
+  BraveShieldsSettingsCache(const BraveShieldsSettingsCache&) = delete;
+  BraveShieldsSettingsCache& operator=(const BraveShieldsSettingsCache&) =
+      delete;
+
+  static BraveShieldsSettingsCache* GetForBrowserContext(
+      content::BrowserContext* browser_context);
+
+  ShieldsSettings GetSettings(const GURL& url);
+
+ private:
+  explicit BraveShieldsSettingsCache(HostContentSettingsMap* map);
+
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  scoped_refptr<HostContentSettingsMap> map_;
+  base::MRUCache<GURL, ShieldsSettings> settings_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_SHIELDS_SETTINGS_CACHE_H_
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_shields_settings_cache.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+class BraveShieldsSettingsCacheTest : public testing::Test {
+ public:
+  BraveShieldsSettingsCacheTest() = default;
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(&profile_);
+  }
+
+  BraveShieldsSettingsCache* cache() {
+    return BraveShieldsSettingsCache::GetForBrowserContext(&profile_);
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+};
+
+TEST_F(BraveShieldsSettingsCacheTest, ResolvesSettings) {
+  const GURL url("https://brave.com/");
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+
+  EXPECT_FALSE(cache()->GetSettings(url).brave_shields_enabled);
+  EXPECT_TRUE(
+      cache()->GetSettings(GURL("https://example.com/")).brave_shields_enabled);
+}
+
+TEST_F(BraveShieldsSettingsCacheTest, ClearedOnContentSettingChange) {
+  const GURL url("https://brave.com/");
+  EXPECT_FALSE(cache()->GetSettings(url).allow_ads);
+
+  brave_shields::SetAdControlType(map(), brave_shields::ControlType::ALLOW,
+                                  url);
+  EXPECT_TRUE(cache()->GetSettings(url).allow_ads);
+}
+
+}  // namespace brave
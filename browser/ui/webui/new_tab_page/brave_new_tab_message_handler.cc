@@ -65,6 +65,9 @@ using ntp_background_images::ViewCounterServiceFactory;
 
 namespace {
 
+constexpr base::TimeDelta kStatsUpdateInterval =
+    base::TimeDelta::FromMilliseconds(500);
+
 bool IsPrivateNewTab(Profile* profile) {
   return profile->IsIncognitoProfile() || profile->IsGuestSession();
 }
@@ -432,6 +435,7 @@ void BraveNewTabMessageHandler::OnJavascriptAllowed() {
 
 void BraveNewTabMessageHandler::OnJavascriptDisallowed() {
   pref_change_registrar_.RemoveAll();
+  stats_update_timer_.Stop();
 #if BUILDFLAG(ENABLE_TOR)
   if (tor_launcher_factory_)
     tor_launcher_factory_->RemoveObserver(this);
@@ -821,6 +825,15 @@ void BraveNewTabMessageHandler::OnPrivatePropertiesChanged() {
 }
 
 void BraveNewTabMessageHandler::OnStatsChanged() {
+  // Pages with many ads change the stats hundreds of times while loading, so
+  // send at most one update per interval.
+  if (stats_update_timer_.IsRunning())
+    return;
+  stats_update_timer_.Start(FROM_HERE, kStatsUpdateInterval, this,
+                            &BraveNewTabMessageHandler::FireStatsUpdated);
+}
+
+void BraveNewTabMessageHandler::FireStatsUpdated() {
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetStatsDictionary(prefs);
   FireWebUIListener("stats-updated", data);
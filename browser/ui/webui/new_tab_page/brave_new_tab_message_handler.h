@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -74,6 +75,7 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void HandleTodayOnDisplayAdView(const base::ListValue* args);
 
   void OnStatsChanged();
+  void FireStatsUpdated();
   void OnPreferencesChanged();
   void OnPrivatePropertiesChanged();
 
@@ -82,6 +84,8 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void OnTorInitializing(const std::string& percentage) override;
 
   PrefChangeRegistrar pref_change_registrar_;
+  // Throttles stats updates, which change for every blocked resource.
+  base::OneShotTimer stats_update_timer_;
   // Weak pointer.
   Profile* profile_;
 #if BUILDFLAG(ENABLE_TOR)
@@ -5,11 +5,60 @@
 
 #include "brave/browser/ui/webui/new_tab_page/brave_new_tab_message_handler.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/test/simple_test_clock.h"
 #include "base/time/time.h"
+#include "base/values.h"
+#include "brave/common/pref_names.h"
 #include "chrome/browser/first_run/first_run.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "content/public/test/test_web_ui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+class BraveNewTabMessageHandlerStatsTest : public testing::Test {
+ public:
+  BraveNewTabMessageHandlerStatsTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+  }
+
+  void SetUp() override {
+    auto handler = std::make_unique<BraveNewTabMessageHandler>(&profile_);
+    handler_ = handler.get();
+    web_ui_.AddMessageHandler(std::move(handler));
+    handler_->AllowJavascriptForTesting();
+  }
+
+  // Returns the "stats-updated" events sent to the page so far.
+  std::vector<const base::Value*> GetStatsUpdates() {
+    std::vector<const base::Value*> updates;
+    for (const auto& call_data : web_ui_.call_data()) {
+      if (call_data->function_name() == "cr.webUIListenerCallback" &&
+          call_data->arg1()->GetString() == "stats-updated") {
+        updates.push_back(call_data->arg2());
+      }
+    }
+    return updates;
+  }
+
+  void FastForwardBy(base::TimeDelta delta) {
+    task_environment_.FastForwardBy(delta);
+  }
+
+  PrefService* prefs() { return profile_.GetPrefs(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+  content::TestWebUI web_ui_;
+  BraveNewTabMessageHandler* handler_ = nullptr;
+};
+
 TEST(BraveNewTabMessageHandlerTest, TalkPrompt) {
   auto* clock = new base::SimpleTestClock();
   clock->SetNow(first_run::GetFirstRunSentinelCreationTime());
@@ -19,3 +68,27 @@ TEST(BraveNewTabMessageHandlerTest, TalkPrompt) {
   clock->Advance(base::TimeDelta::FromDays(1));
   EXPECT_EQ(BraveNewTabMessageHandler::CanPromptBraveTalk(clock->Now()), true);
 }
+
+TEST_F(BraveNewTabMessageHandlerStatsTest, ThrottleStatsUpdates) {
+  prefs()->SetUint64(kAdsBlocked, 1);
+  prefs()->SetUint64(kAdsBlocked, 2);
+  prefs()->SetUint64(kJavascriptBlocked, 1);
+  EXPECT_TRUE(GetStatsUpdates().empty());
+
+  // A single update with the latest stats.
+  FastForwardBy(base::TimeDelta::FromMilliseconds(500));
+  std::vector<const base::Value*> updates = GetStatsUpdates();
+  ASSERT_EQ(1u, updates.size());
+  EXPECT_EQ(2, updates[0]->FindIntKey("adsBlockedStat"));
+  EXPECT_EQ(1, updates[0]->FindIntKey("javascriptBlockedStat"));
+
+  // Nothing is sent while the stats don't change.
+  FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(1u, GetStatsUpdates().size());
+
+  prefs()->SetUint64(kAdsBlocked, 3);
+  FastForwardBy(base::TimeDelta::FromMilliseconds(500));
+  updates = GetStatsUpdates();
+  ASSERT_EQ(2u, updates.size());
+  EXPECT_EQ(3, updates[1]->FindIntKey("adsBlockedStat"));
+}
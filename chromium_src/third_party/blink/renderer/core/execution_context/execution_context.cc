@@ -53,6 +53,23 @@ float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
   return (v / maxUInt64AsDouble) / 10;
 }
 
+// Same as calling ConstantMultiplier for each sample. Kept free of calls so
+// the compiler can vectorize the loop.
+void ConstantMultiplyChannel(double fudge_factor, float* data, size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    data[i] = data[i] * fudge_factor;
+}
+
+// Same as calling PseudoRandomSequence for each sample starting at index 0.
+void FillPseudoRandomSequence(uint64_t seed, float* data, size_t count) {
+  const double maxUInt64AsDouble = UINT64_MAX;
+  uint64_t v = seed;
+  for (size_t i = 0; i < count; ++i) {
+    v = lfsr_next(v);
+    data[i] = (v / maxUInt64AsDouble) / 10;
+  }
+}
+
 }  // namespace
 
 namespace brave {
@@ -138,9 +155,7 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         break;
       }
       case BraveFarblingLevel::BALANCED: {
-        const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
-        double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
+        double fudge_factor = GetAudioFudgeFactor();
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
         return base::BindRepeating(&ConstantMultiplier, fudge_factor);
@@ -154,6 +169,33 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
   return base::BindRepeating(&Identity);
 }
 
+void BraveSessionCache::FarbleAudioChannel(
+    blink::WebContentSettingsClient* settings,
+    float* data,
+    size_t count) {
+  if (!farbling_enabled_ || !settings || !data || count == 0)
+    return;
+  switch (settings->GetBraveFarblingLevel()) {
+    case BraveFarblingLevel::OFF:
+      break;
+    case BraveFarblingLevel::BALANCED: {
+      ConstantMultiplyChannel(GetAudioFudgeFactor(), data, count);
+      break;
+    }
+    case BraveFarblingLevel::MAXIMUM: {
+      uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
+      FillPseudoRandomSequence(seed, data, count);
+      break;
+    }
+  }
+}
+
+double BraveSessionCache::GetAudioFudgeFactor() const {
+  const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
+  const double maxUInt64AsDouble = UINT64_MAX;
+  return 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
+}
+
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
                                       const unsigned char* data,
                                       size_t size) {
@@ -44,6 +44,11 @@ class CORE_EXPORT BraveSessionCache final
 
   AudioFarblingCallback GetAudioFarblingCallback(
       blink::WebContentSettingsClient* settings);
+  // Farbles |count| samples of |data| in place. Gives the same result as
+  // running the callback above over each sample, starting at index 0.
+  void FarbleAudioChannel(blink::WebContentSettingsClient* settings,
+                          float* data,
+                          size_t count);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);
@@ -56,6 +61,7 @@ class CORE_EXPORT BraveSessionCache final
   uint64_t session_key_;
   uint8_t domain_key_[32];
 
+  double GetAudioFudgeFactor() const;
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
 }  // namespace brave
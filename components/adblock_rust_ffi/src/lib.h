@@ -18,6 +18,28 @@ typedef struct C_Engine C_Engine;
  */
 typedef void (*C_DomainResolverCallback)(const char*, uint32_t*, uint32_t*);
 
+/**
+ * Receives a string which is only valid for the duration of the call. The string is not
+ * NUL-terminated.
+ */
+typedef void (*C_StringVisitor)(void*, const char*, size_t);
+
+/**
+ * Receives the parts of the cosmetic filtering resources specific to a url, without them being
+ * serialized.
+ *
+ * `style` is called with each style of the selector passed to the preceding `style_selector`
+ * call.
+ */
+typedef struct C_UrlCosmeticResourcesVisitor {
+  void *user_data;
+  C_StringVisitor hide_selector;
+  C_StringVisitor style_selector;
+  C_StringVisitor style;
+  C_StringVisitor exception;
+  C_StringVisitor injected_script;
+} C_UrlCosmeticResourcesVisitor;
+
 /**
  * Passes a callback to the adblock library, allowing it to be used for domain resolution.
  *
@@ -50,6 +72,26 @@ void engine_match(struct C_Engine *engine,
                   bool *did_match_important,
                   char **redirect);
 
+/**
+ * Checks if a `url` matches for each of the specified `Engine`s within the context.
+ *
+ * The request is only decoded once, and the engines are checked in order with the same block
+ * result semantics as calling `engine_match` for each of them. Checking stops after the first
+ * important match. Returns the index of the engine which decided the block result, or
+ * `engines_size` if none of the engines matched.
+ */
+size_t engine_match_all(struct C_Engine *const *engines,
+                        size_t engines_size,
+                        const char *url,
+                        const char *host,
+                        const char *tab_host,
+                        bool third_party,
+                        const char *resource_type,
+                        bool *did_match_rule,
+                        bool *did_match_exception,
+                        bool *did_match_important,
+                        char **redirect);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document request's response
  * headers.
@@ -122,4 +164,29 @@ char *engine_hidden_class_id_selectors(struct C_Engine *engine,
                                        const char *const *exceptions,
                                        size_t exceptions_size);
 
+/**
+ * Passes the cosmetic filtering resources specific to the given url to `visitor`.
+ *
+ * Returns whether generic hide rules are disabled for the url.
+ */
+bool engine_visit_url_cosmetic_resources(struct C_Engine *engine,
+                                         const char *url,
+                                         const struct C_UrlCosmeticResourcesVisitor *visitor);
+
+/**
+ * Passes each generic cosmetic selector that begins with any of the provided class and id
+ * selectors to `visitor`.
+ *
+ * The leading '.' or '#' character should not be provided
+ */
+void engine_visit_hidden_class_id_selectors(struct C_Engine *engine,
+                                            const char *const *classes,
+                                            size_t classes_size,
+                                            const char *const *ids,
+                                            size_t ids_size,
+                                            const char *const *exceptions,
+                                            size_t exceptions_size,
+                                            C_StringVisitor visitor,
+                                            void *user_data);
+
 #endif /* ADBLOCK_RUST_FFI_H */
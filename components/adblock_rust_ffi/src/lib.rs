@@ -5,6 +5,7 @@ use libc::size_t;
 use std::ffi::CStr;
 use std::ffi::CString;
 use std::os::raw::c_char;
+use std::os::raw::c_void;
 use std::string::String;
 
 /// An external callback that receives a hostname and two out-parameters for start and end
@@ -98,6 +99,77 @@ pub unsafe extern "C" fn engine_match(
     };
 }
 
+/// Checks if a `url` matches for each of the specified `Engine`s within the context.
+///
+/// The request is only decoded once, and the engines are checked in order with the same block
+/// result semantics as calling `engine_match` for each of them. Checking stops after the first
+/// important match. Returns the index of the engine which decided the block result, or
+/// `engines_size` if none of the engines matched.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match_all(
+    engines: *const *mut Engine,
+    engines_size: size_t,
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirect: *mut *mut c_char,
+) -> size_t {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    let host = CStr::from_ptr(host).to_str().unwrap();
+    let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
+    let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
+    let engines = if engines_size == 0 {
+        &[]
+    } else {
+        assert!(!engines.is_null());
+        std::slice::from_raw_parts(engines, engines_size)
+    };
+
+    let mut decided_by = engines_size;
+    let mut redirect_result = None;
+    for (index, &engine) in engines.iter().enumerate() {
+        assert!(!engine.is_null());
+        let engine = &*engine;
+        let blocker_result = engine.check_network_urls_with_hostnames_subset(
+            url,
+            host,
+            tab_host,
+            resource_type,
+            Some(third_party),
+            // Checking normal rules is skipped if a normal rule or exception rule was found previously
+            *did_match_rule || *did_match_exception,
+            // Always check exceptions unless one was found previously
+            !*did_match_exception,
+        );
+        if blocker_result.matched || blocker_result.exception.is_some() || blocker_result.important {
+            decided_by = index;
+        }
+        *did_match_rule |= blocker_result.matched;
+        *did_match_exception |= blocker_result.exception.is_some();
+        *did_match_important |= blocker_result.important;
+        if blocker_result.redirect.is_some() {
+            redirect_result = blocker_result.redirect;
+        }
+        if *did_match_important {
+            break;
+        }
+    }
+
+    *redirect = match redirect_result {
+        Some(x) => match CString::new(x) {
+            Ok(y) => y.into_raw(),
+            _ => ptr::null_mut(),
+        },
+        None => ptr::null_mut(),
+    };
+    decided_by
+}
+
 /// Returns any CSP directives that should be added to a subdocument or document request's response
 /// headers.
 #[no_mangle]
@@ -255,20 +327,104 @@ pub unsafe extern "C" fn engine_hidden_class_id_selectors(
     exceptions: *const *const c_char,
     exceptions_size: size_t,
 ) -> *mut c_char {
-    let classes = std::slice::from_raw_parts(classes, classes_size);
-    let classes: Vec<String> = (0..classes_size)
-        .map(|index| CStr::from_ptr(classes[index]).to_str().unwrap().to_owned())
-        .collect();
-    let ids = std::slice::from_raw_parts(ids, ids_size);
-    let ids: Vec<String> = (0..ids_size)
-        .map(|index| CStr::from_ptr(ids[index]).to_str().unwrap().to_owned())
-        .collect();
-    let exceptions = std::slice::from_raw_parts(exceptions, exceptions_size);
-    let exceptions: std::collections::HashSet<String> = (0..exceptions_size)
-        .map(|index| CStr::from_ptr(exceptions[index]).to_str().unwrap().to_owned())
-        .collect();
+    let classes = strings_from_raw(classes, classes_size);
+    let ids = strings_from_raw(ids, ids_size);
+    let exceptions: std::collections::HashSet<String> =
+        strings_from_raw(exceptions, exceptions_size).into_iter().collect();
     assert!(!engine.is_null());
     let engine = Box::leak(Box::from_raw(engine));
     let stylesheet = engine.hidden_class_id_selectors(&classes, &ids, &exceptions);
     CString::new(serde_json::to_string(&stylesheet).unwrap_or_else(|_| "".into())).expect("Error: CString::new()").into_raw()
 }
+
+/// Receives a string which is only valid for the duration of the call. The string is not
+/// NUL-terminated.
+pub type StringVisitor = unsafe extern "C" fn(*mut c_void, *const c_char, size_t);
+
+/// Receives the parts of the cosmetic filtering resources specific to a url, without them being
+/// serialized.
+///
+/// `style` is called with each style of the selector passed to the preceding `style_selector`
+/// call.
+#[repr(C)]
+pub struct UrlCosmeticResourcesVisitor {
+    pub user_data: *mut c_void,
+    pub hide_selector: StringVisitor,
+    pub style_selector: StringVisitor,
+    pub style: StringVisitor,
+    pub exception: StringVisitor,
+    pub injected_script: StringVisitor,
+}
+
+/// Passes the cosmetic filtering resources specific to the given url to `visitor`.
+///
+/// Returns whether generic hide rules are disabled for the url.
+#[no_mangle]
+pub unsafe extern "C" fn engine_visit_url_cosmetic_resources(
+    engine: *mut Engine,
+    url: *const c_char,
+    visitor: *const UrlCosmeticResourcesVisitor,
+) -> bool {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    assert!(!engine.is_null());
+    assert!(!visitor.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let visitor = &*visitor;
+    let resources = engine.url_cosmetic_resources(url);
+    for selector in resources.hide_selectors.iter() {
+        visit_str(visitor.hide_selector, visitor.user_data, selector);
+    }
+    for (selector, styles) in resources.style_selectors.iter() {
+        visit_str(visitor.style_selector, visitor.user_data, selector);
+        for style in styles.iter() {
+            visit_str(visitor.style, visitor.user_data, style);
+        }
+    }
+    for exception in resources.exceptions.iter() {
+        visit_str(visitor.exception, visitor.user_data, exception);
+    }
+    visit_str(visitor.injected_script, visitor.user_data, &resources.injected_script);
+    resources.generichide
+}
+
+/// Passes each generic cosmetic selector that begins with any of the provided class and id
+/// selectors to `visitor`.
+///
+/// The leading '.' or '#' character should not be provided
+#[no_mangle]
+pub unsafe extern "C" fn engine_visit_hidden_class_id_selectors(
+    engine: *mut Engine,
+    classes: *const *const c_char,
+    classes_size: size_t,
+    ids: *const *const c_char,
+    ids_size: size_t,
+    exceptions: *const *const c_char,
+    exceptions_size: size_t,
+    visitor: StringVisitor,
+    user_data: *mut c_void,
+) {
+    let classes = strings_from_raw(classes, classes_size);
+    let ids = strings_from_raw(ids, ids_size);
+    let exceptions: std::collections::HashSet<String> =
+        strings_from_raw(exceptions, exceptions_size).into_iter().collect();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    for selector in engine.hidden_class_id_selectors(&classes, &ids, &exceptions).iter() {
+        visit_str(visitor, user_data, selector);
+    }
+}
+
+unsafe fn strings_from_raw(strings: *const *const c_char, size: size_t) -> Vec<String> {
+    if size == 0 {
+        return vec![];
+    }
+    let strings = std::slice::from_raw_parts(strings, size);
+    strings
+        .iter()
+        .map(|string| CStr::from_ptr(*string).to_str().unwrap().to_owned())
+        .collect()
+}
+
+unsafe fn visit_str(visitor: StringVisitor, user_data: *mut c_void, value: &str) {
+    visitor(user_data, value.as_ptr() as *const c_char, value.len());
+}
@@ -12,10 +12,29 @@ extern "C" {
 
 namespace adblock {
 
+namespace {
+
+std::vector<const char*> ToRawStrings(const std::vector<std::string>& strings) {
+  std::vector<const char*> strings_raw;
+  strings_raw.reserve(strings.size());
+  for (const std::string& string : strings)
+    strings_raw.push_back(string.c_str());
+  return strings_raw;
+}
+
+}  // namespace
+
 bool SetDomainResolver(DomainResolverCallback resolver) {
   return set_domain_resolver(resolver);
 }
 
+UrlSpecificResources::UrlSpecificResources() = default;
+UrlSpecificResources::UrlSpecificResources(UrlSpecificResources&& other) =
+    default;
+UrlSpecificResources& UrlSpecificResources::operator=(
+    UrlSpecificResources&& other) = default;
+UrlSpecificResources::~UrlSpecificResources() = default;
+
 std::vector<FilterList> FilterList::default_list;
 std::vector<FilterList> FilterList::regional_list;
 
@@ -65,6 +84,36 @@ void Engine::matches(const std::string& url,
   }
 }
 
+// static
+size_t Engine::matchesAll(const std::vector<Engine*>& engines,
+                          const std::string& url,
+                          const std::string& host,
+                          const std::string& tab_host,
+                          bool is_third_party,
+                          const std::string& resource_type,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* redirect) {
+  std::vector<C_Engine*> engines_raw;
+  engines_raw.reserve(engines.size());
+  for (Engine* engine : engines)
+    engines_raw.push_back(engine->raw);
+
+  char* redirect_char_ptr = nullptr;
+  const size_t decided_by = engine_match_all(
+      engines_raw.data(), engines_raw.size(), url.c_str(), host.c_str(),
+      tab_host.c_str(), is_third_party, resource_type.c_str(), did_match_rule,
+      did_match_exception, did_match_important, &redirect_char_ptr);
+  if (redirect_char_ptr) {
+    if (redirect) {
+      *redirect = redirect_char_ptr;
+    }
+    c_char_buffer_destroy(redirect_char_ptr);
+  }
+  return decided_by;
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
@@ -117,23 +166,9 @@ const std::string Engine::hiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  std::vector<const char*> classes_raw;
-  classes_raw.reserve(classes.size());
-  for (size_t i = 0; i < classes.size(); i++) {
-    classes_raw.push_back(classes[i].c_str());
-  }
-
-  std::vector<const char*> ids_raw;
-  ids_raw.reserve(ids.size());
-  for (size_t i = 0; i < ids.size(); i++) {
-    ids_raw.push_back(ids[i].c_str());
-  }
-
-  std::vector<const char*> exceptions_raw;
-  exceptions_raw.reserve(exceptions.size());
-  for (size_t i = 0; i < exceptions.size(); i++) {
-    exceptions_raw.push_back(exceptions[i].c_str());
-  }
+  const std::vector<const char*> classes_raw = ToRawStrings(classes);
+  const std::vector<const char*> ids_raw = ToRawStrings(ids);
+  const std::vector<const char*> exceptions_raw = ToRawStrings(exceptions);
 
   char* stylesheet_raw = engine_hidden_class_id_selectors(
       raw, classes_raw.data(), classes.size(), ids_raw.data(), ids.size(),
@@ -144,6 +179,60 @@ const std::string Engine::hiddenClassIdSelectors(
   return stylesheet;
 }
 
+UrlSpecificResources Engine::getUrlCosmeticResources(const std::string& url) {
+  UrlSpecificResources resources;
+
+  C_UrlCosmeticResourcesVisitor visitor;
+  visitor.user_data = &resources;
+  visitor.hide_selector = [](void* user_data, const char* data, size_t size) {
+    static_cast<UrlSpecificResources*>(user_data)->hide_selectors.emplace_back(
+        data, size);
+  };
+  visitor.style_selector = [](void* user_data, const char* data, size_t size) {
+    static_cast<UrlSpecificResources*>(user_data)->style_selectors.emplace_back(
+        std::string(data, size), std::vector<std::string>());
+  };
+  visitor.style = [](void* user_data, const char* data, size_t size) {
+    auto* resources = static_cast<UrlSpecificResources*>(user_data);
+    if (resources->style_selectors.empty())
+      return;
+    resources->style_selectors.back().second.emplace_back(data, size);
+  };
+  visitor.exception = [](void* user_data, const char* data, size_t size) {
+    static_cast<UrlSpecificResources*>(user_data)->exceptions.emplace_back(
+        data, size);
+  };
+  visitor.injected_script = [](void* user_data, const char* data,
+                               size_t size) {
+    static_cast<UrlSpecificResources*>(user_data)->injected_script.assign(
+        data, size);
+  };
+
+  resources.generichide =
+      engine_visit_url_cosmetic_resources(raw, url.c_str(), &visitor);
+  return resources;
+}
+
+std::vector<std::string> Engine::getHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  const std::vector<const char*> classes_raw = ToRawStrings(classes);
+  const std::vector<const char*> ids_raw = ToRawStrings(ids);
+  const std::vector<const char*> exceptions_raw = ToRawStrings(exceptions);
+
+  std::vector<std::string> selectors;
+  engine_visit_hidden_class_id_selectors(
+      raw, classes_raw.data(), classes.size(), ids_raw.data(), ids.size(),
+      exceptions_raw.data(), exceptions.size(),
+      [](void* user_data, const char* data, size_t size) {
+        static_cast<std::vector<std::string>*>(user_data)->emplace_back(data,
+                                                                        size);
+      },
+      &selectors);
+  return selectors;
+}
+
 Engine::~Engine() {
   engine_destroy(raw);
 }
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_WRAPPER_H_
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 extern "C" {
@@ -64,6 +65,22 @@ class ADBLOCK_EXPORT FilterList {
   static std::vector<FilterList> regional_list;
 };
 
+// Cosmetic filtering resources specific to a url.
+struct ADBLOCK_EXPORT UrlSpecificResources {
+  UrlSpecificResources();
+  UrlSpecificResources(UrlSpecificResources&& other);
+  UrlSpecificResources& operator=(UrlSpecificResources&& other);
+  ~UrlSpecificResources();
+
+  std::vector<std::string> hide_selectors;
+  // Selectors with the styles to apply to them.
+  std::vector<std::pair<std::string, std::vector<std::string>>>
+      style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+};
+
 class ADBLOCK_EXPORT Engine {
  public:
   Engine();
@@ -77,6 +94,20 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_exception,
                bool* did_match_important,
                std::string* redirect);
+  // Matches the request against each of |engines| in order, the same way as
+  // calling |matches| on each of them, but with the request only decoded
+  // once. Returns the index of the engine which decided the result, or
+  // |engines.size()| if none of them matched.
+  static size_t matchesAll(const std::vector<Engine*>& engines,
+                           const std::string& url,
+                           const std::string& host,
+                           const std::string& tab_host,
+                           bool is_third_party,
+                           const std::string& resource_type,
+                           bool* did_match_rule,
+                           bool* did_match_exception,
+                           bool* did_match_important,
+                           std::string* redirect);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
@@ -95,6 +126,13 @@ class ADBLOCK_EXPORT Engine {
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
+  // Same as |urlCosmeticResources| and |hiddenClassIdSelectors|, but the
+  // results are passed across the FFI boundary without being serialized.
+  UrlSpecificResources getUrlCosmeticResources(const std::string& url);
+  std::vector<std::string> getHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
   ~Engine();
 
  private:
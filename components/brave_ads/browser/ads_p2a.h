@@ -11,15 +11,16 @@
 #include <string>
 #include <vector>
 
-class PrefService;
 class PrefRegistrySimple;
+class WeeklyStorageRegistry;
 
 namespace brave_ads {
 
 void RegisterP2APrefs(PrefRegistrySimple* prefs);
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name);
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    WeeklyStorageRegistry* weekly_storages,
+    const std::string& name);
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value);
 
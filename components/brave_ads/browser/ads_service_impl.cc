@@ -61,6 +61,7 @@
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "build/build_config.h"
 #include "chrome/browser/browser_process.h"
@@ -572,6 +573,9 @@ void AdsServiceImpl::Shutdown() {
 
   idle_poll_timer_.Stop();
 
+  if (p2a_weekly_storages_)
+    p2a_weekly_storages_->Flush();
+
   bat_ads_.reset();
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
@@ -2109,9 +2113,14 @@ void AdsServiceImpl::RecordP2AEvent(const std::string& name,
         break;
       }
 
+      if (!p2a_weekly_storages_) {
+        p2a_weekly_storages_ =
+            std::make_unique<WeeklyStorageRegistry>(profile_->GetPrefs());
+      }
+
       for (auto& item : list->GetList()) {
-        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(profile_->GetPrefs(),
-                                                       item.GetString());
+        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+            p2a_weekly_storages_.get(), item.GetString());
       }
       break;
     }
@@ -45,6 +45,7 @@ using brave_rewards::RewardsNotificationService;
 
 class NotificationDisplayService;
 class Profile;
+class WeeklyStorageRegistry;
 
 namespace base {
 class SequencedTaskRunner;
@@ -464,6 +465,9 @@ class AdsServiceImpl : public AdsService,
 
   PrefChangeRegistrar profile_pref_change_registrar_;
 
+  // Weekly P2A event counts, created on first use.
+  std::unique_ptr<WeeklyStorageRegistry> p2a_weekly_storages_;
+
   SimpleURLLoaderList url_loaders_;
 
   NotificationDisplayService* display_service_;     // NOT OWNED
@@ -7,6 +7,7 @@
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
@@ -15,6 +16,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "components/prefs/pref_service.h"
@@ -33,6 +35,10 @@ uint64_t getProfileBandwidthSaved(Browser* browser) {
 }
 
 uint64_t getProfileAdsBlocked(Browser* browser) {
+  // Blocked counts are written to prefs in batches.
+  brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+      browser->tab_strip_model()->GetActiveWebContents())
+      ->FlushBlockedEventsForTesting();
   return browser->profile()->GetPrefs()->GetUint64(
       kAdsBlocked);
 }
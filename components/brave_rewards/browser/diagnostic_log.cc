@@ -5,9 +5,11 @@
 
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 
-#include <memory>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/i18n/time_formatting.h"
 #include "base/strings/stringprintf.h"
@@ -17,8 +19,10 @@
 
 namespace {
 
-const int64_t kChunkSize = 1024;
 const size_t kDividerLength = 80;
+const int64_t kChunkSize = 1024;
+const size_t kMaxPendingLogEntriesSize = 64 * 1024;
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(2);
 
 std::string FormatTime(const base::Time& time) {
   return base::UTF16ToUTF8(
@@ -48,235 +52,148 @@ std::string GetLogVerboseLevelName(int verbose_level) {
   return verbose_level_name;
 }
 
-bool Create(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_CREATE_ALWAYS |
-                                  base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
-}
-
-bool Open(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
+base::FilePath GetPreviousSegmentPath(const base::FilePath& file_path) {
+  return file_path.AddExtensionASCII("1");
 }
 
-bool CreateOrOpen(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
+bool ReadSegment(const base::FilePath& file_path, std::string* data) {
+  DCHECK(data);
 
   if (!base::PathExists(file_path)) {
-    return Create(file_path, file);
-  }
-
-  if (!Open(file_path, file)) {
-    return false;
+    data->clear();
+    return true;
   }
 
-  return file->IsValid();
+  return base::ReadFileToString(file_path, data);
 }
 
-int64_t SeekFromEnd(base::File* file, int num_lines) {
-  DCHECK(file);
-
-  if (!file->IsValid()) {
-    return 0;
-  }
-
-  if (num_lines == 0) {
-    return 0;
-  }
-
-  int64_t length = file->GetLength();
-  if (length == -1) {
-    return -1;
-  }
-
-  if (length == 0) {
-    return 0;
-  }
-
-  int line_count = 0;
-
-  char chunk[kChunkSize];
-  int64_t chunk_size = kChunkSize;
-  int64_t last_chunk_size = 0;
+// Reads the segment at |file_path| backwards in chunks of |kChunkSize|,
+// adding them to |chunks| from last to first. |line_count| carries the
+// number of line breaks already seen in later segments. Returns true once
+// the start of the last |num_lines| lines has been read, or if reading
+// failed, so the previous segment is only read when it is needed.
+bool ReadSegmentBackwards(const base::FilePath& file_path,
+                          int num_lines,
+                          int* line_count,
+                          std::vector<std::string>* chunks) {
+  DCHECK(line_count);
+  DCHECK(chunks);
 
-  if (file->Seek(base::File::FROM_END, 0) == -1) {
-    return -1;
+  if (!base::PathExists(file_path)) {
+    return false;
   }
 
-  do {
-    if (chunk_size > length) {
-      chunk_size = length;
-    }
-
-    const int64_t seek_offset = chunk_size + last_chunk_size;
-    if (file->Seek(base::File::FROM_CURRENT, -seek_offset) == -1) {
-      return -1;
-    }
-
-    if (file->ReadAtCurrentPos(chunk, chunk_size) == -1) {
-      return -1;
-    }
-
-    for (int i = chunk_size - 1; i >= 0; i--) {
-      if (chunk[i] == '\n') {
-        line_count++;
-        if (line_count == num_lines + 1) {
-          return length;
-        }
-      }
-
-      length--;
-    }
-
-    last_chunk_size = chunk_size;
-  } while (length > 0);
-
-  return length;
-}
-
-bool TrimBeginningOfFile(base::File* file, int keep_num_lines) {
-  DCHECK(file);
-
-  if (file->GetLength() == 0) {
+  base::File file(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
     return true;
   }
 
-  const int64_t offset = SeekFromEnd(file, keep_num_lines);
+  int64_t offset = file.GetLength();
   if (offset == -1) {
-    return false;
-  }
-
-  if (offset == 0) {
     return true;
   }
 
-  if (file->Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return false;
-  }
-
-  const int64_t size = file->GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file->ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return false;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, 0) == -1) {
-    return false;
-  }
-
-  const std::string data = std::string(buffer.get());
-  const int64_t new_size = data.size();
-
-  if (file->WriteAtCurrentPos(data.c_str(), new_size) == -1) {
-    return false;
-  }
-
-  if (!file->SetLength(new_size)) {
-    return false;
-  }
+  std::string chunk;
+  while (offset > 0) {
+    const int64_t chunk_size = std::min(kChunkSize, offset);
+    offset -= chunk_size;
 
-  return true;
-}
-
-bool MaybeTrimBeginningOfFile(base::File* file,
-                              int64_t max_file_size,
-                              int keep_num_lines,
-                              bool first_write) {
-  DCHECK(file);
+    chunk.resize(chunk_size);
+    if (file.Read(offset, &chunk[0], chunk_size) != chunk_size) {
+      return true;
+    }
 
-  const int64_t length = file->GetLength();
-  if (length == -1) {
-    return false;
-  }
+    for (int64_t i = chunk_size - 1; i >= 0; i--) {
+      if (chunk[i] != '\n') {
+        continue;
+      }
 
-  // We do not trim the log on first run so that if the browser
-  // crashes and we investigate the log with the user they are able to
-  // re-run the browser without losing past logs.
-  if (!first_write && length <= max_file_size) {
-    return true;
-  }
+      (*line_count)++;
+      if (*line_count == num_lines + 1) {
+        chunks->push_back(chunk.substr(i + 1));
+        return true;
+      }
+    }
 
-  if (!TrimBeginningOfFile(file, keep_num_lines)) {
-    return false;
+    chunks->push_back(chunk);
   }
 
-  return true;
+  return false;
 }
 
 std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
                                            int num_lines) {
-  base::File file;
-  if (!Open(file_path, &file)) {
-    return "";
-  }
-
-  if (file.GetLength() == 0) {
-    return "";
-  }
-
-  int64_t offset;
+  const base::FilePath previous_file_path = GetPreviousSegmentPath(file_path);
 
   if (num_lines == -1) {
-    offset = 0;
-  } else {
-    offset = SeekFromEnd(&file, num_lines);
-    if (offset == -1) {
+    std::string previous;
+    if (!ReadSegment(previous_file_path, &previous)) {
+      previous.clear();
+    }
+
+    std::string current;
+    if (!ReadSegment(file_path, &current)) {
       return "";
     }
-  }
 
-  if (file.Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return "";
+    return previous + current;
   }
 
-  const int64_t size = file.GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
+  int line_count = 0;
+  std::vector<std::string> chunks;
+  if (!ReadSegmentBackwards(file_path, num_lines, &line_count, &chunks)) {
+    ReadSegmentBackwards(previous_file_path, num_lines, &line_count, &chunks);
+  }
 
-  if (file.ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return "";
+  std::string data;
+  for (auto iter = chunks.rbegin(); iter != chunks.rend(); ++iter) {
+    data += *iter;
   }
 
-  return std::string(buffer.get());
+  return data;
 }
 
 bool WriteOnFileTaskRunner(const base::FilePath& file_path,
-                           const std::string& log_entry,
+                           const std::string& log_entries,
                            int64_t max_file_size,
-                           int keep_num_lines,
                            bool first_write) {
-  base::File file;
-  if (!CreateOrOpen(file_path, &file)) {
+  base::File file(file_path,
+                  base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!file.IsValid()) {
     return false;
   }
 
-  if (file.Seek(base::File::FROM_END, 0) == -1) {
-    return false;
+  std::string data;
+  if (first_write) {
+    data = std::string(kDividerLength, '-') + "\n";
   }
+  data += log_entries;
 
-  if (first_write) {
-    const std::string divider = std::string(kDividerLength, '-') + "\n";
-    file.WriteAtCurrentPos(divider.c_str(), divider.length());
+  if (file.WriteAtCurrentPos(data.c_str(), data.length()) == -1) {
+    return false;
   }
 
-  if (file.WriteAtCurrentPos(log_entry.c_str(), log_entry.length()) == -1) {
+  const int64_t length = file.GetLength();
+  if (length == -1) {
     return false;
   }
 
-  return MaybeTrimBeginningOfFile(&file, max_file_size, keep_num_lines,
-                                  first_write);
+  if (length <= max_file_size / 2) {
+    return true;
+  }
+
+  // The current segment is full, so it replaces the previous segment and
+  // the next write starts a new one. The previous segment is kept so that
+  // the log always holds at least half of |max_file_size|.
+  file.Close();
+  return base::ReplaceFile(file_path, GetPreviousSegmentPath(file_path),
+                           nullptr);
 }
 
 bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
-  return base::DeleteFile(file_path);
+  const bool deleted_previous =
+      base::DeleteFile(GetPreviousSegmentPath(file_path));
+  return base::DeleteFile(file_path) && deleted_previous;
 }
 
 }  // namespace
@@ -284,22 +201,22 @@ bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
 namespace brave_rewards {
 
 DiagnosticLog::DiagnosticLog(const base::FilePath& file_path,
-                             int64_t max_file_size,
-                             int keep_num_lines)
+                             int64_t max_file_size)
     : file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
           {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       file_path_(file_path),
       max_file_size_(max_file_size),
-      keep_num_lines_(keep_num_lines),
       first_write_(true) {}
 
 DiagnosticLog::~DiagnosticLog() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
 }
 
 void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&ReadLastNLinesOnFileTaskRunner, file_path_, num_lines),
@@ -310,13 +227,18 @@ void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
 void DiagnosticLog::Write(const std::string& log_entry,
                           StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  file_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&WriteOnFileTaskRunner, file_path_, log_entry,
-                     max_file_size_, keep_num_lines_, first_write_),
-      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
-                     std::move(callback)));
-  first_write_ = false;
+  pending_log_entries_ += log_entry;
+  pending_callbacks_.push_back(std::move(callback));
+
+  if (pending_log_entries_.length() >= kMaxPendingLogEntriesSize) {
+    Flush();
+    return;
+  }
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kFlushDelay,
+                       base::BindOnce(&DiagnosticLog::Flush, AsWeakPtr()));
+  }
 }
 
 void DiagnosticLog::Write(const std::string& log_entry,
@@ -342,21 +264,47 @@ void DiagnosticLog::Write(const std::string& log_entry,
 
 void DiagnosticLog::Delete(StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE, base::BindOnce(&DeleteOnFileTaskRunner, file_path_),
       base::BindOnce(&DiagnosticLog::OnDelete, AsWeakPtr(),
                      std::move(callback)));
 }
 
+void DiagnosticLog::Flush() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  flush_timer_.Stop();
+
+  if (pending_log_entries_.empty()) {
+    return;
+  }
+
+  std::string log_entries;
+  log_entries.swap(pending_log_entries_);
+  std::vector<StatusCallback> callbacks;
+  callbacks.swap(pending_callbacks_);
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&WriteOnFileTaskRunner, file_path_,
+                     std::move(log_entries), max_file_size_, first_write_),
+      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
+                     std::move(callbacks)));
+  first_write_ = false;
+}
+
 void DiagnosticLog::OnReadLastNLines(ReadCallback callback,
                                      const std::string& data) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   std::move(callback).Run(data);
 }
 
-void DiagnosticLog::OnWrite(StatusCallback callback, bool result) {
+void DiagnosticLog::OnWrite(std::vector<StatusCallback> callbacks,
+                            bool result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  std::move(callback).Run(result);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(result);
+  }
 }
 
 void DiagnosticLog::OnDelete(StatusCallback callback, bool result) {
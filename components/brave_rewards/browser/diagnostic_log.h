@@ -7,22 +7,23 @@
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_H_
 
 #include <string>
+#include <vector>
 
-#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
+#include "base/timer/timer.h"
 
 namespace brave_rewards {
 
-// This class provides access to a diagnostic log file. If the file
-// size ever exceeds the provided maximum file size, it is trimmed to
-// keep only the last n lines.
+// This class provides access to a diagnostic log file. Log entries are
+// buffered in memory and appended to disk in batches. The log is stored as
+// two segments, |path| and |path|.1, each holding at most half of the
+// provided maximum file size. When the current segment is full it replaces
+// the previous segment, so trimming the log never rewrites any data.
 class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
  public:
-  DiagnosticLog(const base::FilePath& path,
-                int64_t max_file_size,
-                int keep_num_lines);
+  DiagnosticLog(const base::FilePath& path, int64_t max_file_size);
   DiagnosticLog(const DiagnosticLog&) = delete;
   DiagnosticLog& operator=(const DiagnosticLog&) = delete;
   ~DiagnosticLog();
@@ -30,13 +31,12 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
   using ReadCallback = base::OnceCallback<void(const std::string& data)>;
   using StatusCallback = base::OnceCallback<void(bool result)>;
 
-  // Reads last |num_lines| lines of file. If |num_lines| is -1, reads
-  // the entire file.
+  // Reads last |num_lines| lines of the log. If |num_lines| is -1, reads
+  // the entire log. Buffered entries are flushed first.
   void ReadLastNLines(int num_lines, ReadCallback callback);
 
-  // Appends |log_entry| to end of file. If file doesn't exist, it is
-  // created. If total file size exceeds |max_file_size|, removes all
-  // but the last |keep_num_lines| lines.
+  // Appends |log_entry| to the log. The entry is buffered and |callback| is
+  // run once the buffer has been flushed to disk.
   void Write(const std::string& log_entry, StatusCallback callback);
   void Write(const std::string& log_entry,
              const base::Time& time,
@@ -45,19 +45,23 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
              int verbose_level,
              StatusCallback callback);
 
-  // Deletes the file.
+  // Deletes the log, including any buffered entries.
   void Delete(StatusCallback callback);
 
  private:
+  void Flush();
+
   void OnReadLastNLines(ReadCallback callback, const std::string& data);
-  void OnWrite(StatusCallback callback, bool result);
+  void OnWrite(std::vector<StatusCallback> callbacks, bool result);
   void OnDelete(StatusCallback callback, bool result);
 
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   base::FilePath file_path_;
   int64_t max_file_size_;
-  int keep_num_lines_;
   bool first_write_;
+  std::string pending_log_entries_;
+  std::vector<StatusCallback> pending_callbacks_;
+  base::OneShotTimer flush_timer_;
 
   SEQUENCE_CHECKER(sequence_checker_);
 };
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_restrictions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DiagnosticLogTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+// Written before the first batch of entries of each session
+std::string GetDivider() {
+  return std::string(80, '-') + "\n";
+}
+
+}  // namespace
+
+class DiagnosticLogTest : public testing::Test {
+ protected:
+  DiagnosticLogTest() = default;
+  ~DiagnosticLogTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+  }
+
+  void CreateLog(int64_t max_file_size) {
+    log_ = std::make_unique<DiagnosticLog>(file_path_, max_file_size);
+  }
+
+  // Appends |log_entry| and waits until it has been flushed to disk.
+  void WriteAndFlush(const std::string& log_entry) {
+    base::RunLoop run_loop;
+    log_->Write(log_entry, base::BindLambdaForTesting([&](bool result) {
+                  EXPECT_TRUE(result);
+                  run_loop.Quit();
+                }));
+    run_loop.Run();
+  }
+
+  std::string ReadLastNLines(int num_lines) {
+    std::string data;
+    base::RunLoop run_loop;
+    log_->ReadLastNLines(
+        num_lines, base::BindLambdaForTesting([&](const std::string& result) {
+          data = result;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return data;
+  }
+
+  bool PathExists(const base::FilePath& path) {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    return base::PathExists(path);
+  }
+
+  base::FilePath GetPreviousSegmentPath() const {
+    return file_path_.AddExtensionASCII("1");
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  base::FilePath file_path_;
+  std::unique_ptr<DiagnosticLog> log_;
+};
+
+TEST_F(DiagnosticLogTest, ReadFlushesBufferedEntries) {
+  CreateLog(1024 * 1024);
+
+  log_->Write("line 1\n", base::DoNothing());
+  log_->Write("line 2\n", base::DoNothing());
+  log_->Write("line 3\n", base::DoNothing());
+
+  EXPECT_EQ("line 2\nline 3\n", ReadLastNLines(2));
+  EXPECT_EQ(GetDivider() + "line 1\nline 2\nline 3\n", ReadLastNLines(-1));
+}
+
+TEST_F(DiagnosticLogTest, ReadMoreLinesThanLogged) {
+  CreateLog(1024 * 1024);
+
+  WriteAndFlush("line 1\n");
+
+  EXPECT_EQ(GetDivider() + "line 1\n", ReadLastNLines(10));
+}
+
+TEST_F(DiagnosticLogTest, ReadLastNLinesAcrossChunks) {
+  CreateLog(1024 * 1024);
+
+  // Each line is 100 bytes, so the last lines span several read chunks
+  std::string expected_data;
+  for (int i = 0; i < 200; i++) {
+    const std::string line =
+        base::StringPrintf("line %03d ", i) + std::string(90, 'x') + "\n";
+    log_->Write(line, base::DoNothing());
+    if (i >= 170) {
+      expected_data += line;
+    }
+  }
+
+  EXPECT_EQ(expected_data, ReadLastNLines(30));
+}
+
+TEST_F(DiagnosticLogTest, RotatesFullSegment) {
+  // Each segment holds at most 100 bytes
+  CreateLog(200);
+
+  WriteAndFlush("line 1\n");
+  WriteAndFlush("line 2\n");
+  EXPECT_FALSE(PathExists(GetPreviousSegmentPath()));
+
+  WriteAndFlush("line 3\n");
+  EXPECT_TRUE(PathExists(GetPreviousSegmentPath()));
+  EXPECT_FALSE(PathExists(file_path_));
+
+  WriteAndFlush("line 4\n");
+  EXPECT_TRUE(PathExists(file_path_));
+
+  EXPECT_EQ(GetDivider() + "line 1\nline 2\nline 3\nline 4\n",
+            ReadLastNLines(-1));
+}
+
+TEST_F(DiagnosticLogTest, ReadLastNLinesAcrossSegments) {
+  CreateLog(200);
+
+  WriteAndFlush("line 1\n");
+  WriteAndFlush("line 2\n");
+  WriteAndFlush("line 3\n");
+  WriteAndFlush("line 4\n");
+  WriteAndFlush("line 5\n");
+
+  EXPECT_EQ("line 5\n", ReadLastNLines(1));
+  EXPECT_EQ("line 4\nline 5\n", ReadLastNLines(2));
+  EXPECT_EQ("line 2\nline 3\nline 4\nline 5\n", ReadLastNLines(4));
+}
+
+TEST_F(DiagnosticLogTest, DeleteFlushesBufferedEntries) {
+  CreateLog(200);
+
+  WriteAndFlush("line 1\n");
+  WriteAndFlush("line 2\n");
+  WriteAndFlush("line 3\n");
+  log_->Write("line 4\n", base::DoNothing());
+
+  base::RunLoop run_loop;
+  log_->Delete(base::BindLambdaForTesting([&](bool result) {
+    EXPECT_TRUE(result);
+    run_loop.Quit();
+  }));
+  run_loop.Run();
+
+  EXPECT_FALSE(PathExists(file_path_));
+  EXPECT_FALSE(PathExists(GetPreviousSegmentPath()));
+  EXPECT_EQ("", ReadLastNLines(-1));
+}
+
+}  // namespace brave_rewards
@@ -102,7 +102,6 @@ static const unsigned int kRetriesCountOnNetworkChange = 1;
 namespace {
 
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kDiagnosticLogKeepNumLines = 20000;
 const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
 const char pref_prefix[] = "brave.rewards";
 
@@ -328,8 +327,7 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
       diagnostic_log_(
           new DiagnosticLog(profile_->GetPath().Append(kDiagnosticLogPath),
-                            kDiagnosticLogMaxFileSize,
-                            kDiagnosticLogKeepNumLines)),
+                            kDiagnosticLogMaxFileSize)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
       next_timer_id_(0) {
   // Set up the rewards data source
@@ -344,6 +342,7 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
 RewardsServiceImpl::~RewardsServiceImpl() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (ledger_database_) {
+    FlushPendingDBTransactions();
     file_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
   }
   StopNotificationTimers();
@@ -1470,6 +1469,7 @@ void RewardsServiceImpl::Reset() {
   bat_ledger_client_receiver_.reset();
   bat_ledger_service_.reset();
   ready_ = std::make_unique<base::OneShotEvent>();
+  FlushPendingDBTransactions();
   bool success =
       file_task_runner_->DeleteSoon(FROM_HERE, ledger_database_.release());
   BLOG_IF(1, !success, "Database was not released");
@@ -3127,36 +3127,85 @@ void RewardsServiceImpl::ReconcileStampReset() {
   }
 }
 
-ledger::type::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
-    ledger::type::DBTransactionPtr transaction,
+std::vector<ledger::type::DBCommandResponsePtr>
+RunDBTransactionsOnFileTaskRunner(
+    std::vector<ledger::type::DBTransactionPtr> transactions,
     ledger::LedgerDatabase* database) {
-  auto response = ledger::type::DBCommandResponse::New();
+  std::vector<ledger::type::DBCommandResponsePtr> responses;
   if (!database) {
-    response->status = ledger::type::DBCommandResponse::Status::RESPONSE_ERROR;
+    for (size_t i = 0; i < transactions.size(); i++) {
+      auto response = ledger::type::DBCommandResponse::New();
+      response->status =
+          ledger::type::DBCommandResponse::Status::RESPONSE_ERROR;
+      responses.push_back(std::move(response));
+    }
   } else {
-    database->RunTransaction(std::move(transaction), response.get());
+    database->RunTransactions(std::move(transactions), &responses);
   }
 
-  return response;
+  return responses;
 }
 
 void RewardsServiceImpl::RunDBTransaction(
     ledger::type::DBTransactionPtr transaction,
     ledger::client::RunDBTransactionCallback callback) {
   DCHECK(ledger_database_);
+  pending_db_transactions_.push_back(std::move(transaction));
+  pending_db_callbacks_.push_back(std::move(callback));
+
+  if (!db_transactions_running_) {
+    RunPendingDBTransactions();
+  }
+}
+
+void RewardsServiceImpl::RunPendingDBTransactions() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (pending_db_transactions_.empty()) {
+    return;
+  }
+
+  db_transactions_running_ = true;
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&RunDBTransactionOnFileTaskRunner, std::move(transaction),
+      base::BindOnce(&RunDBTransactionsOnFileTaskRunner,
+                     std::move(pending_db_transactions_),
                      ledger_database_.get()),
-      base::BindOnce(&RewardsServiceImpl::OnRunDBTransaction, AsWeakPtr(),
-                     std::move(callback)));
+      base::BindOnce(&RewardsServiceImpl::OnRunDBTransactions, AsWeakPtr(),
+                     std::move(pending_db_callbacks_)));
+  pending_db_transactions_.clear();
+  pending_db_callbacks_.clear();
+}
+
+void RewardsServiceImpl::FlushPendingDBTransactions() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_db_callbacks_.clear();
+  if (pending_db_transactions_.empty() || !ledger_database_) {
+    pending_db_transactions_.clear();
+    return;
+  }
+
+  // Nobody is left to handle the responses, but the transactions must still
+  // run before the database is deleted on the same sequence
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&RunDBTransactionsOnFileTaskRunner),
+                     std::move(pending_db_transactions_),
+                     ledger_database_.get()));
+  pending_db_transactions_.clear();
 }
 
-void RewardsServiceImpl::OnRunDBTransaction(
-    ledger::client::RunDBTransactionCallback callback,
-    ledger::type::DBCommandResponsePtr response) {
+void RewardsServiceImpl::OnRunDBTransactions(
+    std::vector<ledger::client::RunDBTransactionCallback> callbacks,
+    std::vector<ledger::type::DBCommandResponsePtr> responses) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  callback(std::move(response));
+  DCHECK_EQ(callbacks.size(), responses.size());
+  for (size_t i = 0; i < callbacks.size() && i < responses.size(); i++) {
+    callbacks[i](std::move(responses[i]));
+  }
+
+  // Transactions started by the callbacks above join the next batch
+  db_transactions_running_ = false;
+  RunPendingDBTransactions();
 }
 
 void RewardsServiceImpl::GetCreateScript(
@@ -716,9 +716,13 @@ class RewardsServiceImpl : public RewardsService,
       const ledger::type::Result result,
       ledger::type::MonthlyReportInfoPtr report);
 
-  void OnRunDBTransaction(
-      ledger::client::RunDBTransactionCallback callback,
-      ledger::type::DBCommandResponsePtr response);
+  void RunPendingDBTransactions();
+
+  void FlushPendingDBTransactions();
+
+  void OnRunDBTransactions(
+      std::vector<ledger::client::RunDBTransactionCallback> callbacks,
+      std::vector<ledger::type::DBCommandResponsePtr> responses);
 
   void OnGetAllMonthlyReportIds(
       GetAllMonthlyReportIdsCallback callback,
@@ -777,6 +781,11 @@ class RewardsServiceImpl : public RewardsService,
 
   std::unique_ptr<DiagnosticLog> diagnostic_log_;
   std::unique_ptr<ledger::LedgerDatabase> ledger_database_;
+  // Transactions received while a batch is running on the file task runner,
+  // they are sent together as the next batch
+  std::vector<ledger::type::DBTransactionPtr> pending_db_transactions_;
+  std::vector<ledger::client::RunDBTransactionCallback> pending_db_callbacks_;
+  bool db_transactions_running_ = false;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
   std::unique_ptr<RewardsServiceObserver> extension_observer_;
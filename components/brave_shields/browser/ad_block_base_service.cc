@@ -11,8 +11,8 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -99,6 +99,16 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   return filter_option;
 }
 
+// Determine third-party here so the library doesn't need to figure it out.
+// CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+// a URL or origin and not a string to a host name.
+bool IsThirdPartyRequest(const GURL& url, const std::string& tab_host) {
+  return !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+}
+
 }  // namespace
 
 namespace brave_shields {
@@ -122,13 +132,7 @@ void AdBlockBaseService::ShouldStartRequest(
     std::string* mock_data_url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
+  bool is_third_party = IsThirdPartyRequest(url, tab_host);
   ad_block_client_->matches(
       url.spec(), url.host(), tab_host, is_third_party,
       ResourceTypeToString(resource_type), did_match_rule,
@@ -140,19 +144,30 @@ void AdBlockBaseService::ShouldStartRequest(
   //  << ", url.spec(): " << url.spec();
 }
 
+// static
+size_t AdBlockBaseService::ShouldStartRequestForEngines(
+    const std::vector<adblock::Engine*>& engines,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
+  return adblock::Engine::matchesAll(
+      engines, url.spec(), url.host(), tab_host,
+      IsThirdPartyRequest(url, tab_host), ResourceTypeToString(resource_type),
+      did_match_rule, did_match_exception, did_match_important,
+      mock_data_url);
+}
+
 absl::optional<std::string> AdBlockBaseService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
+  bool is_third_party = IsThirdPartyRequest(url, tab_host);
   const std::string result = ad_block_client_->getCspDirectives(
       url.spec(), url.host(), tab_host, is_third_party,
       ResourceTypeToString(resource_type));
@@ -201,19 +216,34 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-absl::optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
-    const std::string& url) {
+cosmetic_filters::mojom::UrlSpecificResourcesPtr
+AdBlockBaseService::UrlCosmeticResources(const std::string& url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  adblock::UrlSpecificResources engine_resources =
+      ad_block_client_->getUrlCosmeticResources(url);
+
+  auto resources = cosmetic_filters::mojom::UrlSpecificResources::New();
+  resources->hide_selectors = std::move(engine_resources.hide_selectors);
+  resources->style_selectors =
+      base::flat_map<std::string, std::vector<std::string>>(
+          std::move(engine_resources.style_selectors));
+  resources->exceptions = std::move(engine_resources.exceptions);
+  resources->injected_script = std::move(engine_resources.injected_script);
+  resources->generichide = engine_resources.generichide;
+  return resources;
 }
 
-absl::optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockBaseService::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  return ad_block_client_->getHiddenClassIdSelectors(classes, ids, exceptions);
+}
+
+adblock::Engine* AdBlockBaseService::GetEngine() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return ad_block_client_.get();
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
@@ -19,6 +19,7 @@
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
 class AdBlockServiceTest;
@@ -56,13 +57,18 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  virtual absl::optional<base::Value> UrlCosmeticResources(
-      const std::string& url);
-  virtual absl::optional<base::Value> HiddenClassIdSelectors(
+  virtual cosmetic_filters::mojom::UrlSpecificResourcesPtr
+  UrlCosmeticResources(const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // Returns the engine, so that it can be queried in a batch with the engines
+  // of other services. Engines are only replaced or deleted on the task
+  // runner, so the result stays valid until the end of the current task.
+  adblock::Engine* GetEngine();
+
  protected:
   friend class ::AdBlockServiceTest;
   friend class ::BraveAdBlockTPNetworkDelegateHelperTest;
@@ -74,6 +80,20 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
 
+  // Matches the request against each of |engines| in order, the same way as
+  // calling ShouldStartRequest on each of their services, but with the
+  // request only prepared once. Returns the index of the engine which decided
+  // the result, or |engines.size()| if none of them matched.
+  static size_t ShouldStartRequestForEngines(
+      const std::vector<adblock::Engine*>& engines,
+      const GURL& url,
+      blink::mojom::ResourceType resource_type,
+      const std::string& tab_host,
+      bool* did_match_rule,
+      bool* did_match_exception,
+      bool* did_match_important,
+      std::string* mock_data_url);
+
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
  private:
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -115,23 +116,14 @@ bool AdBlockRegionalServiceManager::Start() {
   return true;
 }
 
-void AdBlockRegionalServiceManager::ShouldStartRequest(
-    const GURL& url,
-    blink::mojom::ResourceType resource_type,
-    const std::string& tab_host,
-    bool* did_match_rule,
-    bool* did_match_exception,
-    bool* did_match_important,
-    std::string* mock_data_url) {
+void AdBlockRegionalServiceManager::GetEngines(
+    std::vector<adblock::Engine*>* engines,
+    std::vector<std::string>* uuids) {
   base::AutoLock lock(regional_services_lock_);
 
   for (const auto& regional_service : regional_services_) {
-    regional_service.second->ShouldStartRequest(
-        url, resource_type, tab_host, did_match_rule, did_match_exception,
-        did_match_important, mock_data_url);
-    if (did_match_important && *did_match_important) {
-      return;
-    }
+    engines->push_back(regional_service.second->GetEngine());
+    uuids->push_back(regional_service.first);
   }
 }
 
@@ -201,61 +193,44 @@ void AdBlockRegionalServiceManager::EnableFilterList(
                      base::Unretained(this), uuid, enabled));
 }
 
-absl::optional<base::Value> AdBlockRegionalServiceManager::UrlCosmeticResources(
-    const std::string& url) {
+cosmetic_filters::mojom::UrlSpecificResourcesPtr
+AdBlockRegionalServiceManager::UrlCosmeticResources(const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return absl::optional<base::Value>();
-  }
-  absl::optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
-
-  for ( ; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
-    if (first_value) {
-      if (next_value) {
-        MergeResourcesInto(std::move(*next_value), &*first_value, false);
-      }
+  cosmetic_filters::mojom::UrlSpecificResourcesPtr resources;
+  for (const auto& regional_service : regional_services_) {
+    cosmetic_filters::mojom::UrlSpecificResourcesPtr next_resources =
+        regional_service.second->UrlCosmeticResources(url);
+    if (resources) {
+      MergeResourcesInto(std::move(next_resources), resources.get(),
+                         /*force_hide=*/false);
     } else {
-      first_value = std::move(next_value);
+      resources = std::move(next_resources);
     }
   }
 
-  return first_value;
+  return resources;
 }
 
-absl::optional<base::Value>
-AdBlockRegionalServiceManager::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockRegionalServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return absl::optional<base::Value>();
-  }
-  absl::optional<base::Value> first_value =
-      it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  for ( ; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-    if (first_value && first_value->is_list()) {
-      if (next_value && next_value->is_list()) {
-        for (auto i = next_value->GetList().begin();
-                i < next_value->GetList().end();
-                i++) {
-          first_value->Append(std::move(*i));
-        }
-      }
+  std::vector<std::string> selectors;
+  for (const auto& regional_service : regional_services_) {
+    std::vector<std::string> next_selectors =
+        regional_service.second->HiddenClassIdSelectors(classes, ids,
+                                                         exceptions);
+    if (selectors.empty()) {
+      selectors = std::move(next_selectors);
     } else {
-      first_value = std::move(next_value);
+      selectors.insert(selectors.end(),
+                       std::make_move_iterator(next_selectors.begin()),
+                       std::make_move_iterator(next_selectors.end()));
     }
   }
 
-  return first_value;
+  return selectors;
 }
 
 void AdBlockRegionalServiceManager::SetRegionalCatalog(
@@ -17,6 +17,7 @@
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -47,13 +48,11 @@ class AdBlockRegionalServiceManager {
 
   bool IsInitialized() const;
   bool Start();
-  void ShouldStartRequest(const GURL& url,
-                          blink::mojom::ResourceType resource_type,
-                          const std::string& tab_host,
-                          bool* did_match_rule,
-                          bool* did_match_exception,
-                          bool* did_match_important,
-                          std::string* mock_data_url);
+  // Appends the engine of each enabled regional list to |engines|, and the
+  // list's uuid to |uuids|. See AdBlockBaseService::GetEngine() for how long
+  // the engines remain valid.
+  void GetEngines(std::vector<adblock::Engine*>* engines,
+                  std::vector<std::string>* uuids);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -62,8 +61,9 @@ class AdBlockRegionalServiceManager {
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  absl::optional<base::Value> HiddenClassIdSelectors(
+  cosmetic_filters::mojom::UrlSpecificResourcesPtr UrlCosmeticResources(
+      const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
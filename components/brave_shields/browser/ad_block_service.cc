@@ -6,11 +6,11 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/feature_list.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -23,7 +23,6 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
-#include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -70,23 +69,39 @@ void AdBlockService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  AdBlockBaseService::ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
-  if (did_match_important && *did_match_important) {
-    return;
-  }
+  ShouldStartRequest(url, resource_type, tab_host, did_match_rule,
+                     did_match_exception, did_match_important, mock_data_url,
+                     nullptr);
+}
 
-  regional_service_manager()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
-  if (did_match_important && *did_match_important) {
-    return;
+void AdBlockService::ShouldStartRequest(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url,
+    std::string* matched_list_id) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+
+  // The default, regional and custom engines are queried in one batch, in
+  // that order, so the request is only prepared once for all of them.
+  std::vector<adblock::Engine*> engines = {GetEngine()};
+  std::vector<std::string> list_ids = {g_ad_block_component_id_};
+  regional_service_manager()->GetEngines(&engines, &list_ids);
+  engines.push_back(custom_filters_service()->GetEngine());
+  list_ids.push_back(kCustomFiltersListId);
+
+  const size_t decided_by = ShouldStartRequestForEngines(
+      engines, url, resource_type, tab_host, did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
+  if (matched_list_id) {
+    if (decided_by < list_ids.size())
+      *matched_list_id = list_ids[decided_by];
+    else
+      matched_list_id->clear();
   }
-
-  custom_filters_service()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
 }
 
 absl::optional<std::string> AdBlockService::GetCspDirectives(
@@ -107,82 +122,42 @@ absl::optional<std::string> AdBlockService::GetCspDirectives(
   return csp_directives;
 }
 
-absl::optional<base::Value> AdBlockService::UrlCosmeticResources(
-    const std::string& url) {
-  absl::optional<base::Value> resources =
+cosmetic_filters::mojom::UrlSpecificResourcesPtr
+AdBlockService::UrlCosmeticResources(const std::string& url) {
+  cosmetic_filters::mojom::UrlSpecificResourcesPtr resources =
       AdBlockBaseService::UrlCosmeticResources(url);
 
-  if (!resources || !resources->is_dict()) {
-    return resources;
-  }
-
-  absl::optional<base::Value> regional_resources =
-      regional_service_manager()->UrlCosmeticResources(url);
+  MergeResourcesInto(regional_service_manager()->UrlCosmeticResources(url),
+                     resources.get(), /*force_hide=*/false);
 
-  if (regional_resources && regional_resources->is_dict()) {
-    MergeResourcesInto(std::move(*regional_resources), &*resources,
-                       /*force_hide=*/false);
-  }
-
-  absl::optional<base::Value> custom_resources =
-      custom_filters_service()->UrlCosmeticResources(url);
-
-  if (custom_resources && custom_resources->is_dict()) {
-    MergeResourcesInto(std::move(*custom_resources), &*resources,
-                       /*force_hide=*/true);
-  }
+  MergeResourcesInto(custom_filters_service()->UrlCosmeticResources(url),
+                     resources.get(), /*force_hide=*/true);
 
   return resources;
 }
 
-absl::optional<base::Value> AdBlockService::HiddenClassIdSelectors(
+void AdBlockService::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
-    const std::vector<std::string>& exceptions) {
-  absl::optional<base::Value> hide_selectors =
+    const std::vector<std::string>& exceptions,
+    std::vector<std::string>* hide_selectors,
+    std::vector<std::string>* force_hide_selectors) {
+  DCHECK(hide_selectors);
+  DCHECK(force_hide_selectors);
+
+  *hide_selectors =
       AdBlockBaseService::HiddenClassIdSelectors(classes, ids, exceptions);
 
-  absl::optional<base::Value> regional_selectors =
+  std::vector<std::string> regional_selectors =
       regional_service_manager()->HiddenClassIdSelectors(classes, ids,
                                                          exceptions);
+  hide_selectors->insert(hide_selectors->end(),
+                         std::make_move_iterator(regional_selectors.begin()),
+                         std::make_move_iterator(regional_selectors.end()));
 
-  absl::optional<base::Value> custom_selectors =
+  *force_hide_selectors =
       custom_filters_service()->HiddenClassIdSelectors(classes, ids,
                                                        exceptions);
-
-  if (hide_selectors && hide_selectors->is_list()) {
-    if (regional_selectors && regional_selectors->is_list()) {
-      for (auto i = regional_selectors->GetList().begin();
-           i < regional_selectors->GetList().end(); i++) {
-        hide_selectors->Append(std::move(*i));
-      }
-    }
-  } else {
-    hide_selectors = std::move(regional_selectors);
-  }
-
-#if !defined(OS_ANDROID) && !defined(CHROME_OS)
-  if (!base::FeatureList::IsEnabled(
-          brave_shields::features::kBraveAdblockCosmeticFilteringNative)) {
-    auto result_list = std::make_unique<base::ListValue>();
-    if (hide_selectors && hide_selectors->is_list()) {
-      result_list->Append(std::move(*hide_selectors));
-    }
-    if (custom_selectors && custom_selectors->is_list()) {
-      result_list->Append(std::move(*custom_selectors));
-    }
-
-    return std::move(*result_list);
-  }
-#endif
-
-  if (!hide_selectors || !hide_selectors->is_list())
-    hide_selectors = base::ListValue();
-
-  if (custom_selectors && custom_selectors->is_list())
-    hide_selectors->Append(std::move(*custom_selectors));
-
-  return hide_selectors;
 }
 
 AdBlockRegionalServiceManager* AdBlockService::regional_service_manager() {
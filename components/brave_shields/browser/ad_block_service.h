@@ -42,6 +42,8 @@ const char kAdBlockComponentBase64PublicKey[] =
     "vqOhBOogCdb9qza5eJ1Cgx8RWKucFfaWWxKLOelCiBMT1Hm1znAoVBHG/blhJJOD"
     "5HcH/heRrB4MvrE1J76WF3fvZ03aHVcnlLtQeiNNOZ7VbBDXdie8Nomf/QswbBGa"
     "VwIDAQAB";
+// Identifies the user's custom filters in filter list attribution.
+const char kCustomFiltersListId[] = "custom";
 
 // The brave shields service in charge of ad-block checking and init.
 class AdBlockService : public AdBlockBaseService {
@@ -56,16 +58,31 @@ class AdBlockService : public AdBlockBaseService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
+  // Same as above, and also sets |matched_list_id| to the id of the filter
+  // list which decided the result: kAdBlockComponentId for the default list,
+  // the uuid of a regional list or kCustomFiltersListId. It is left empty
+  // when no list matched.
+  void ShouldStartRequest(const GURL& url,
+                          blink::mojom::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url,
+                          std::string* matched_list_id);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
-  absl::optional<base::Value> UrlCosmeticResources(
+  cosmetic_filters::mojom::UrlSpecificResourcesPtr UrlCosmeticResources(
       const std::string& url) override;
-  absl::optional<base::Value> HiddenClassIdSelectors(
-      const std::vector<std::string>& classes,
-      const std::vector<std::string>& ids,
-      const std::vector<std::string>& exceptions) override;
+  // Custom filter selectors are returned separately in
+  // |force_hide_selectors|, as they apply to first party content too.
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids,
+                              const std::vector<std::string>& exceptions,
+                              std::vector<std::string>* hide_selectors,
+                              std::vector<std::string>* force_hide_selectors);
 
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
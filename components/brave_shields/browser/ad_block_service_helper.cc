@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "base/json/json_reader.h"
@@ -17,6 +18,20 @@ using adblock::FilterList;
 
 namespace brave_shields {
 
+namespace {
+
+void AppendStrings(std::vector<std::string> from,
+                   std::vector<std::string>* into) {
+  if (into->empty()) {
+    *into = std::move(from);
+    return;
+  }
+  into->insert(into->end(), std::make_move_iterator(from.begin()),
+               std::make_move_iterator(from.end()));
+}
+
+}  // namespace
+
 std::vector<FilterList>::const_iterator FindAdBlockFilterListByUUID(
     const std::vector<FilterList>& region_lists,
     const std::string& uuid) {
@@ -138,80 +153,40 @@ void MergeCspDirectiveInto(absl::optional<std::string> from,
   *into = absl::optional<std::string>(from_str + ", " + into_str);
 }
 
-// Merges the contents of the first UrlCosmeticResources Value into the second
-// one provided.
+// Merges the contents of the first UrlSpecificResources into the second one
+// provided.
 //
 // If `force_hide` is true, the contents of `from`'s `hide_selectors` field
-// will be moved into a possibly new field of `into` called
-// `force_hide_selectors`.
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide) {
-  base::Value* resources_hide_selectors = nullptr;
-  if (force_hide) {
-    resources_hide_selectors = into->FindKey("force_hide_selectors");
-    if (!resources_hide_selectors || !resources_hide_selectors->is_list()) {
-        into->SetKey("force_hide_selectors", base::ListValue());
-        resources_hide_selectors = into->FindKey("force_hide_selectors");
-    }
-  } else {
-    resources_hide_selectors = into->FindKey("hide_selectors");
-  }
-  base::Value* from_resources_hide_selectors =
-      from.FindKey("hide_selectors");
-  if (resources_hide_selectors && from_resources_hide_selectors) {
-    for (auto i = from_resources_hide_selectors->GetList().begin();
-            i < from_resources_hide_selectors->GetList().end();
-            i++) {
-      resources_hide_selectors->Append(std::move(*i));
-    }
-  }
+// will be moved into the `force_hide_selectors` field of `into`.
+void MergeResourcesInto(cosmetic_filters::mojom::UrlSpecificResourcesPtr from,
+                        cosmetic_filters::mojom::UrlSpecificResources* into,
+                        bool force_hide) {
+  DCHECK(into);
+  if (!from)
+    return;
 
-  base::Value* resources_style_selectors = into->FindKey("style_selectors");
-  base::Value* from_resources_style_selectors =
-      from.FindKey("style_selectors");
-  if (resources_style_selectors && from_resources_style_selectors) {
-    for (auto i : from_resources_style_selectors->DictItems()) {
-      base::Value* resources_entry =
-          resources_style_selectors->FindKey(i.first);
-      if (resources_entry) {
-        for (auto j = i.second.GetList().begin();
-                j < i.second.GetList().end();
-                j++) {
-          resources_entry->Append(std::move(*j));
-        }
-      } else {
-        resources_style_selectors->SetKey(i.first, std::move(i.second));
-      }
+  std::vector<std::string>& hide_selectors =
+      force_hide ? into->force_hide_selectors : into->hide_selectors;
+  AppendStrings(std::move(from->hide_selectors), &hide_selectors);
+
+  for (auto& style_selector : from->style_selectors) {
+    auto it = into->style_selectors.find(style_selector.first);
+    if (it == into->style_selectors.end()) {
+      into->style_selectors.emplace(style_selector.first,
+                                    std::move(style_selector.second));
+    } else {
+      AppendStrings(std::move(style_selector.second), &it->second);
     }
   }
 
-  base::Value* resources_exceptions = into->FindKey("exceptions");
-  base::Value* from_resources_exceptions = from.FindKey("exceptions");
-  if (resources_exceptions && from_resources_exceptions) {
-    for (auto i = from_resources_exceptions->GetList().begin();
-            i < from_resources_exceptions->GetList().end();
-            i++) {
-      resources_exceptions->Append(std::move(*i));
-    }
-  }
+  AppendStrings(std::move(from->exceptions), &into->exceptions);
 
-  base::Value* resources_injected_script = into->FindKey("injected_script");
-  base::Value* from_resources_injected_script =
-      from.FindKey("injected_script");
-  if (resources_injected_script && from_resources_injected_script) {
-    *resources_injected_script = base::Value(
-            resources_injected_script->GetString()
-            + '\n'
-            + from_resources_injected_script->GetString());
-  }
+  into->injected_script.reserve(into->injected_script.size() + 1 +
+                                from->injected_script.size());
+  into->injected_script += '\n';
+  into->injected_script += from->injected_script;
 
-  base::Value* resources_generichide = into->FindKey("generichide");
-  base::Value* from_resources_generichide =
-      from.FindKey("generichide");
-  if (from_resources_generichide) {
-    if (from_resources_generichide->GetBool()) {
-      *resources_generichide = base::Value(true);
-    }
-  }
+  into->generichide |= from->generichide;
 }
 
 }  // namespace brave_shields
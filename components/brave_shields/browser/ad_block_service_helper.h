@@ -12,6 +12,7 @@
 
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 
 namespace brave_shields {
 
@@ -28,7 +29,9 @@ std::vector<adblock::FilterList> RegionalCatalogFromJSON(
 void MergeCspDirectiveInto(absl::optional<std::string> from,
                            absl::optional<std::string>* into);
 
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide);
+void MergeResourcesInto(cosmetic_filters::mojom::UrlSpecificResourcesPtr from,
+                        cosmetic_filters::mojom::UrlSpecificResources* into,
+                        bool force_hide);
 
 }  // namespace brave_shields
 
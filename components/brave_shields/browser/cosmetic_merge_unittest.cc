@@ -3,7 +3,11 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#include "base/json/json_reader.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -11,30 +15,57 @@
 namespace brave_shields {
 
 using ::testing::_;
+using cosmetic_filters::mojom::UrlSpecificResources;
+using cosmetic_filters::mojom::UrlSpecificResourcesPtr;
+
+namespace {
+
+using StyleSelectors = base::flat_map<std::string, std::vector<std::string>>;
+
+UrlSpecificResourcesPtr MakeResources(
+    const std::vector<std::string>& hide_selectors,
+    const StyleSelectors& style_selectors,
+    const std::vector<std::string>& exceptions,
+    const std::string& injected_script,
+    bool generichide) {
+  auto resources = UrlSpecificResources::New();
+  resources->hide_selectors = hide_selectors;
+  resources->style_selectors = style_selectors;
+  resources->exceptions = exceptions;
+  resources->injected_script = injected_script;
+  resources->generichide = generichide;
+  return resources;
+}
+
+UrlSpecificResourcesPtr EmptyResources() {
+  return MakeResources({}, {}, {}, "", false);
+}
+
+UrlSpecificResourcesPtr NonEmptyResources() {
+  return MakeResources({"a", "b"},
+                       {{"c", {"color: #fff"}}, {"d", {"color: #000"}}},
+                       {"e", "f"}, "console.log('g')", false);
+}
+
+}  // namespace
 
 class CosmeticResourceMergeTest : public testing::Test {
  public:
   CosmeticResourceMergeTest() {}
   ~CosmeticResourceMergeTest() override {}
 
-  void CompareMergeFromStrings(
-          const std::string& a,
-          const std::string& b,
-          bool force_hide,
-          const std::string& expected) {
-    absl::optional<base::Value> a_val = base::JSONReader::Read(a);
-    ASSERT_TRUE(a_val);
-
-    absl::optional<base::Value> b_val = base::JSONReader::Read(b);
-    ASSERT_TRUE(b_val);
-
-    const absl::optional<base::Value> expected_val =
-        base::JSONReader::Read(expected);
-    ASSERT_TRUE(expected_val);
-
-    MergeResourcesInto(std::move(b_val.value()), &*a_val, force_hide);
-
-    ASSERT_EQ(*a_val, *expected_val);
+  void CompareMerge(UrlSpecificResourcesPtr a,
+                    UrlSpecificResourcesPtr b,
+                    bool force_hide,
+                    UrlSpecificResourcesPtr expected) {
+    MergeResourcesInto(std::move(b), a.get(), force_hide);
+
+    EXPECT_EQ(expected->hide_selectors, a->hide_selectors);
+    EXPECT_EQ(expected->force_hide_selectors, a->force_hide_selectors);
+    EXPECT_EQ(expected->style_selectors, a->style_selectors);
+    EXPECT_EQ(expected->exceptions, a->exceptions);
+    EXPECT_EQ(expected->injected_script, a->injected_script);
+    EXPECT_EQ(expected->generichide, a->generichide);
   }
 
  protected:
@@ -43,268 +74,128 @@ class CosmeticResourceMergeTest : public testing::Test {
   void TearDown() override {}
 };
 
-const char EMPTY_RESOURCES[] = "{"
-    "\"hide_selectors\": [], "
-    "\"style_selectors\": {}, "
-    "\"exceptions\": [], "
-    "\"injected_script\": \"\", "
-    "\"generichide\": false"
-"}";
-
-const char NONEMPTY_RESOURCES[] = "{"
-    "\"hide_selectors\": [\"a\", \"b\"], "
-    "\"style_selectors\": {"
-        "\"c\": [\"color: #fff\"], "
-        "\"d\": [\"color: #000\"]"
-    "}, "
-    "\"exceptions\": [\"e\", \"f\"], "
-    "\"injected_script\": \"console.log('g')\", "
-    "\"generichide\": false"
-"}";
-
 TEST_F(CosmeticResourceMergeTest, MergeTwoEmptyResources) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
-
-  // Same as EMPTY_RESOURCES, but with an additional newline in the
+  // Same as EmptyResources(), but with an additional newline in the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  CompareMerge(EmptyResources(), EmptyResources(), false,
+               MakeResources({}, {}, {}, "\n", false));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeEmptyIntoNonEmpty) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
-
   // Same as a, but with an additional newline at the end of the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\"], "
-      "\"injected_script\": \"console.log('g')\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  CompareMerge(NonEmptyResources(), EmptyResources(), false,
+               MakeResources({"a", "b"},
+                             {{"c", {"color: #fff"}}, {"d", {"color: #000"}}},
+                             {"e", "f"}, "console.log('g')\n", false));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoEmpty) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = NONEMPTY_RESOURCES;
-
   // Same as b, but with an additional newline at the beginning of the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"],"
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\"], "
-      "\"injected_script\": \"\nconsole.log('g')\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  CompareMerge(EmptyResources(), NonEmptyResources(), false,
+               MakeResources({"a", "b"},
+                             {{"c", {"color: #fff"}}, {"d", {"color: #000"}}},
+                             {"e", "f"}, "\nconsole.log('g')", false));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoNonEmpty) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\", \"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  UrlSpecificResourcesPtr b =
+      MakeResources({"h", "i"},
+                    {{"j", {"color: #eee"}}, {"k", {"color: #111"}}},
+                    {"l", "m"}, "console.log('n')", false);
+
+  CompareMerge(NonEmptyResources(), std::move(b), false,
+               MakeResources({"a", "b", "h", "i"},
+                             {{"c", {"color: #fff"}},
+                              {"d", {"color: #000"}},
+                              {"j", {"color: #eee"}},
+                              {"k", {"color: #111"}}},
+                             {"e", "f", "l", "m"},
+                             "console.log('g')\nconsole.log('n')", false));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeEmptyForceHide) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
-
-  // Same as EMPTY_RESOURCES, but with an additional newline in the
-  // injected_script and a new empty `force_hide_selectors` array
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\","
-      "\"generichide\": false, "
-      "\"force_hide_selectors\": []"
-  "}";
-
-  CompareMergeFromStrings(a, b, true, expected);
+  // Same as EmptyResources(), but with an additional newline in the
+  // injected_script
+  CompareMerge(EmptyResources(), EmptyResources(), true,
+               MakeResources({}, {}, {}, "\n", false));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyForceHide) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\","
-      "\"generichide\": false, "
-      "\"force_hide_selectors\": [\"h\", \"i\"]"
-  "}";
-
-  CompareMergeFromStrings(a, b, true, expected);
+  UrlSpecificResourcesPtr b =
+      MakeResources({"h", "i"},
+                    {{"j", {"color: #eee"}}, {"k", {"color: #111"}}},
+                    {"l", "m"}, "console.log('n')", false);
+
+  UrlSpecificResourcesPtr expected =
+      MakeResources({"a", "b"},
+                    {{"c", {"color: #fff"}},
+                     {"d", {"color: #000"}},
+                     {"j", {"color: #eee"}},
+                     {"k", {"color: #111"}}},
+                    {"e", "f", "l", "m"},
+                    "console.log('g')\nconsole.log('n')", false);
+  expected->force_hide_selectors = {"h", "i"};
+
+  CompareMerge(NonEmptyResources(), std::move(b), true, std::move(expected));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonGenerichideIntoGenerichide) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": true"
-  "}";
-  const std::string b = EMPTY_RESOURCES;
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\n\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  CompareMerge(MakeResources({}, {}, {}, "\n", true), EmptyResources(), false,
+               MakeResources({}, {}, {}, "\n\n", true));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoNonGenerichide) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": true"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\", \"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  UrlSpecificResourcesPtr b =
+      MakeResources({"h", "i"},
+                    {{"j", {"color: #eee"}}, {"k", {"color: #111"}}},
+                    {"l", "m"}, "console.log('n')", true);
+
+  CompareMerge(NonEmptyResources(), std::move(b), false,
+               MakeResources({"a", "b", "h", "i"},
+                             {{"c", {"color: #fff"}},
+                              {"d", {"color: #000"}},
+                              {"j", {"color: #eee"}},
+                              {"k", {"color: #111"}}},
+                             {"e", "f", "l", "m"},
+                             "console.log('g')\nconsole.log('n')", true));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoGenerichide) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": true"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, a, false, expected);
+  CompareMerge(MakeResources({}, {}, {}, "", true),
+               MakeResources({}, {}, {}, "", true), false,
+               MakeResources({}, {}, {}, "\n", true));
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeStyles) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".a\": [\"color: #eee\"], "
-          "\".b\": [\"color: #111\"], "
-          "\".d\": [\"padding: 0\"]"
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": false"
-  "}";
-  const std::string b = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".c\": [\"margin: 0\"], "
-          "\".b\": [\"background: #000\"], "
-          "\".a\": [\"background: #fff\"]"
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".a\": [\"color: #eee\", \"background: #fff\"], "
-          "\".b\": [\"color: #111\", \"background: #000\"], "
-          "\".c\": [\"margin: 0\"], "
-          "\".d\": [\"padding: 0\"] "
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  UrlSpecificResourcesPtr a = MakeResources({},
+                                            {{".a", {"color: #eee"}},
+                                             {".b", {"color: #111"}},
+                                             {".d", {"padding: 0"}}},
+                                            {}, "", false);
+  UrlSpecificResourcesPtr b = MakeResources({},
+                                            {{".c", {"margin: 0"}},
+                                             {".b", {"background: #000"}},
+                                             {".a", {"background: #fff"}}},
+                                            {}, "", false);
+
+  CompareMerge(std::move(a), std::move(b), false,
+               MakeResources({},
+                             {{".a", {"color: #eee", "background: #fff"}},
+                              {".b", {"color: #111", "background: #000"}},
+                              {".c", {"margin: 0"}},
+                              {".d", {"padding: 0"}}},
+                             {}, "\n", false));
 }
 
+TEST_F(CosmeticResourceMergeTest, MergeNullResources) {
+  UrlSpecificResourcesPtr a = NonEmptyResources();
+
+  MergeResourcesInto(nullptr, a.get(), false);
+
+  EXPECT_EQ("console.log('g')", a->injected_script);
+  EXPECT_EQ(std::vector<std::string>({"a", "b"}), a->hide_selectors);
+}
 
 }  // namespace brave_shields
@@ -28,3 +28,35 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Sharded) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(256, 8);
+
+  for (int i = 0; i < 32; ++i)
+    cache.add("k" + std::to_string(i), "v" + std::to_string(i));
+
+  std::string v;
+  ASSERT_TRUE(cache.get("k7", &v));
+  ASSERT_STREQ(v.c_str(), "v7");
+  ASSERT_FALSE(cache.get("missing", &v));
+
+  cache.clear();
+  ASSERT_FALSE(cache.get("k7", &v));
+}
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Counters) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(10, 2);
+
+  // Empty values are valid entries, e.g. negative lookups.
+  cache.add("kA", "");
+  std::string v = "unset";
+  ASSERT_TRUE(cache.get("kA", &v));
+  ASSERT_TRUE(v.empty());
+  ASSERT_FALSE(cache.get("kB", &v));
+  ASSERT_FALSE(cache.get("kC", &v));
+
+  EXPECT_EQ(1u, cache.hits());
+  EXPECT_EQ(2u, cache.misses());
+}
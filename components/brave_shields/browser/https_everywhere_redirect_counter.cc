@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+
+#include "base/check_op.h"
+
+namespace brave_shields {
+
+namespace {
+
+// The low byte of a slot holds the redirect count, the rest holds the low
+// 56 bits of the request identifier.
+constexpr int kCountBits = 8;
+constexpr uint64_t kCountMask = (uint64_t{1} << kCountBits) - 1;
+
+uint64_t TagFor(uint64_t request_identifier) {
+  return request_identifier << kCountBits;
+}
+
+}  // namespace
+
+HTTPSERedirectCounter::HTTPSERedirectCounter(size_t slot_count)
+    : slot_count_(slot_count),
+      slots_(new std::atomic<uint64_t>[slot_count]) {
+  DCHECK_GT(slot_count_, 0u);
+  for (size_t i = 0; i < slot_count_; ++i)
+    slots_[i].store(0, std::memory_order_relaxed);
+}
+
+HTTPSERedirectCounter::~HTTPSERedirectCounter() = default;
+
+std::atomic<uint64_t>& HTTPSERedirectCounter::SlotFor(
+    uint64_t request_identifier) const {
+  return slots_[request_identifier % slot_count_];
+}
+
+unsigned int HTTPSERedirectCounter::GetCount(
+    uint64_t request_identifier) const {
+  const uint64_t value =
+      SlotFor(request_identifier).load(std::memory_order_relaxed);
+  if ((value & ~kCountMask) != TagFor(request_identifier))
+    return 0;
+  return static_cast<unsigned int>(value & kCountMask);
+}
+
+void HTTPSERedirectCounter::Increment(uint64_t request_identifier) {
+  std::atomic<uint64_t>& slot = SlotFor(request_identifier);
+  const uint64_t tag = TagFor(request_identifier);
+  uint64_t value = slot.load(std::memory_order_relaxed);
+  uint64_t new_value;
+  do {
+    if ((value & ~kCountMask) != tag) {
+      new_value = tag | 1;
+    } else if ((value & kCountMask) == kCountMask) {
+      // Saturate instead of wrapping into the identifier bits.
+      return;
+    } else {
+      new_value = value + 1;
+    }
+  } while (!slot.compare_exchange_weak(value, new_value,
+                                       std::memory_order_relaxed));
+}
+
+}  // namespace brave_shields
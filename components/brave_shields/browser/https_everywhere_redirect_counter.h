@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/macros.h"
+
+namespace brave_shields {
+
+// Counts HTTPSE redirects per request to break redirect loops. Requests are
+// hashed into a fixed ring of slots; each slot packs the request identifier
+// and its redirect count into one atomic word, so both lookups and updates
+// are constant time and take no lock. When two live requests collide on a
+// slot the newer one takes it over, which only resets the older count.
+class HTTPSERedirectCounter {
+ public:
+  explicit HTTPSERedirectCounter(size_t slot_count);
+  ~HTTPSERedirectCounter();
+
+  // Returns the number of redirects recorded for |request_identifier|.
+  unsigned int GetCount(uint64_t request_identifier) const;
+
+  // Records one more redirect for |request_identifier|.
+  void Increment(uint64_t request_identifier);
+
+ private:
+  std::atomic<uint64_t>& SlotFor(uint64_t request_identifier) const;
+
+  const size_t slot_count_;
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERedirectCounter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_REDIRECT_COUNTER_H_
@@ -0,0 +1,79 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "base/timer/lap_timer.h"
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "HTTPSERedirectCounter.";
+constexpr char kMetricLookupTime[] = "lookup_time";
+constexpr int kLookupsPerThread = 100000;
+
+// Simulates the request path: every request checks whether it may still be
+// redirected and then records a redirect.
+class RequestPathThread : public base::SimpleThread {
+ public:
+  RequestPathThread(HTTPSERedirectCounter* counter, uint64_t first_request)
+      : base::SimpleThread("RequestPathThread"),
+        counter_(counter),
+        first_request_(first_request) {}
+
+  void Run() override {
+    for (int i = 0; i < kLookupsPerThread; ++i) {
+      const uint64_t request_identifier = first_request_ + i % 64;
+      if (counter_->GetCount(request_identifier) < 4)
+        counter_->Increment(request_identifier);
+    }
+  }
+
+ private:
+  HTTPSERedirectCounter* counter_;
+  const uint64_t first_request_;
+};
+
+void RunConcurrentLookups(const std::string& story, int thread_count) {
+  HTTPSERedirectCounter counter(1024);
+  base::LapTimer timer;
+  do {
+    std::vector<std::unique_ptr<RequestPathThread>> threads;
+    for (int i = 0; i < thread_count; ++i) {
+      threads.push_back(
+          std::make_unique<RequestPathThread>(&counter, i * 1000 + 1));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads)
+      thread->Join();
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricLookupTime, "ns");
+  reporter.AddResult(kMetricLookupTime,
+                     timer.TimePerLap().InNanoseconds() /
+                         static_cast<double>(kLookupsPerThread * thread_count));
+}
+
+}  // namespace
+
+TEST(HTTPSEverywhereRedirectCounterPerfTest, SingleThread) {
+  RunConcurrentLookups("1_thread", 1);
+}
+
+TEST(HTTPSEverywhereRedirectCounterPerfTest, ManyThreads) {
+  RunConcurrentLookups("16_threads", 16);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERedirectCounter;
+
+TEST(HTTPSEverywhereRedirectCounterTest, CountsPerRequest) {
+  HTTPSERedirectCounter counter(16);
+  EXPECT_EQ(0u, counter.GetCount(1));
+
+  counter.Increment(1);
+  counter.Increment(1);
+  counter.Increment(2);
+  EXPECT_EQ(2u, counter.GetCount(1));
+  EXPECT_EQ(1u, counter.GetCount(2));
+  EXPECT_EQ(0u, counter.GetCount(3));
+}
+
+TEST(HTTPSEverywhereRedirectCounterTest, CollidingRequestTakesOverSlot) {
+  HTTPSERedirectCounter counter(16);
+  counter.Increment(1);
+  counter.Increment(1);
+
+  // 17 maps to the same slot as 1.
+  counter.Increment(17);
+  EXPECT_EQ(1u, counter.GetCount(17));
+  EXPECT_EQ(0u, counter.GetCount(1));
+}
+
+TEST(HTTPSEverywhereRedirectCounterTest, Saturates) {
+  HTTPSERedirectCounter counter(4);
+  for (int i = 0; i < 1000; ++i)
+    counter.Increment(5);
+  EXPECT_EQ(255u, counter.GetCount(5));
+  EXPECT_EQ(0u, counter.GetCount(6));
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::unique_ptr<re2::RE2> CompilePattern(const std::string& pattern) {
+  auto regex = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  // An invalid pattern never matched with the uncompiled engine either.
+  if (!regex->ok())
+    return nullptr;
+  return regex;
+}
+
+}  // namespace
+
+HTTPSERuleSet::Rule::Rule() = default;
+HTTPSERuleSet::Rule::Rule(Rule&&) = default;
+HTTPSERuleSet::Rule::~Rule() = default;
+
+HTTPSERuleSet::Ruleset::Ruleset() = default;
+HTTPSERuleSet::Ruleset::Ruleset(Ruleset&&) = default;
+HTTPSERuleSet::Ruleset::~Ruleset() = default;
+
+HTTPSERuleSet::HTTPSERuleSet() = default;
+HTTPSERuleSet::~HTTPSERuleSet() = default;
+
+// static
+scoped_refptr<HTTPSERuleSet> HTTPSERuleSet::Parse(const std::string& json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return nullptr;
+
+  scoped_refptr<HTTPSERuleSet> rule_set(new HTTPSERuleSet());
+  for (const auto& item : json_object->GetList()) {
+    if (!item.is_dict())
+      continue;
+
+    Ruleset ruleset;
+    const base::Value* exclusions = item.FindListKey("e");
+    if (exclusions) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        auto regex = CompilePattern(CorrectToRuleToRE2Engine(*pattern));
+        if (regex)
+          ruleset.exclusions.push_back(std::move(regex));
+      }
+    }
+
+    const base::Value* rules = item.FindListKey("r");
+    if (!rules) {
+      // Nothing after a ruleset without rules is ever reached.
+      rule_set->rulesets_.push_back(std::move(ruleset));
+      break;
+    }
+    ruleset.has_rules = true;
+
+    for (const auto& rule_value : rules->GetList()) {
+      if (!rule_value.is_dict())
+        continue;
+      Rule rule;
+      if (rule_value.FindKey("d")) {
+        rule.is_default = true;
+        ruleset.rules.push_back(std::move(rule));
+        // A default rule always applies, later rules are unreachable.
+        break;
+      }
+
+      const std::string* from = rule_value.FindStringKey("f");
+      const std::string* to = rule_value.FindStringKey("t");
+      if (!from || !to)
+        continue;
+      rule.from = CompilePattern(*from);
+      if (!rule.from)
+        continue;
+      rule.to = CorrectToRuleToRE2Engine(*to);
+      ruleset.rules.push_back(std::move(rule));
+    }
+    rule_set->rulesets_.push_back(std::move(ruleset));
+  }
+
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& url) const {
+  for (const auto& ruleset : rulesets_) {
+    for (const auto& exclusion : ruleset.exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion))
+        return std::string();
+    }
+
+    if (!ruleset.has_rules)
+      return std::string();
+
+    for (const auto& rule : ruleset.rules) {
+      if (rule.is_default) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url)
+        return new_url;
+    }
+  }
+  return std::string();
+}
+
+// static
+std::string HTTPSERuleSet::CorrectToRuleToRE2Engine(const std::string& to) {
+  std::string corrected_to(to);
+  size_t pos = corrected_to.find('$');
+  while (std::string::npos != pos) {
+    corrected_to[pos] = '\\';
+    pos = corrected_to.find('$', pos + 1);
+  }
+  return corrected_to;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// Compiled form of a single HTTPS Everywhere leveldb value. The JSON value is
+// decoded and every exclusion and rewrite pattern is compiled into an RE2
+// object exactly once, so applying the rules to a URL only runs the matcher.
+// Instances are immutable after creation and may be shared across threads.
+class HTTPSERuleSet : public base::RefCountedThreadSafe<HTTPSERuleSet> {
+ public:
+  // Returns nullptr if |json| is not a list of rulesets.
+  static scoped_refptr<HTTPSERuleSet> Parse(const std::string& json);
+
+  // Returns the upgraded URL for |url|, or an empty string if |url| is
+  // excluded or no rule rewrites it.
+  std::string Apply(const std::string& url) const;
+
+  // Replaces '$' back-references with the '\' form understood by RE2.
+  static std::string CorrectToRuleToRE2Engine(const std::string& to);
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSERuleSet>;
+
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    ~Rule();
+
+    // A default rule only swaps the scheme to https.
+    bool is_default = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Ruleset {
+    Ruleset();
+    Ruleset(Ruleset&&);
+    ~Ruleset();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // When the ruleset has no rule list, lookup stops after its exclusions.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleSet();
+  ~HTTPSERuleSet();
+
+  std::vector<Ruleset> rulesets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
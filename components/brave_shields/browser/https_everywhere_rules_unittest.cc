@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleSet;
+
+TEST(HTTPSEverywhereRulesTest, InvalidJson) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse(""));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{}"));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("[{"));
+}
+
+TEST(HTTPSEverywhereRulesTest, DefaultRule) {
+  auto rule_set = HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("https://example.com/", rule_set->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, RewriteRule) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      R"([{"r": [{"f": "^http://www\\.example\\.com/(.*)",)"
+      R"( "t": "https://secure.example.com/$1"}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("https://secure.example.com/path?q=1",
+            rule_set->Apply("http://www.example.com/path?q=1"));
+  EXPECT_EQ("", rule_set->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, Exclusions) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      R"([{"e": [{"p": "^http://example\\.com/insecure/.*"}],)"
+      R"( "r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("", rule_set->Apply("http://example.com/insecure/page"));
+  EXPECT_EQ("https://example.com/page",
+            rule_set->Apply("http://example.com/page"));
+}
+
+TEST(HTTPSEverywhereRulesTest, MissingRulesStopsLookup) {
+  auto rule_set =
+      HTTPSERuleSet::Parse(R"([{"e": []}, {"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("", rule_set->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, InvalidPatternIsSkipped) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      R"([{"r": [{"f": "(", "t": "https://a/"},)"
+      R"( {"f": "^http:", "t": "https:"}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("https://example.com/", rule_set->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesTest, CorrectToRuleToRE2Engine) {
+  EXPECT_EQ("https://\\1.example.com/\\2",
+            HTTPSERuleSet::CorrectToRuleToRE2Engine(
+                "https://$1.example.com/$2"));
+}
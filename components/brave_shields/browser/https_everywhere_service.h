@@ -11,11 +11,13 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_redirect_counter.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
 
 namespace leveldb {
 class DB;
@@ -31,17 +33,9 @@ extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
+// Rule sets that apply to a host, ordered from the most to the least specific
+// domain. An empty list means the host has no rules.
+using HTTPSEHostRules = std::vector<scoped_refptr<HTTPSERuleSet>>;
 
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
@@ -63,9 +57,9 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled rules stored under the leveldb |key|, decoding and
+  // caching them on first use.
+  scoped_refptr<HTTPSERuleSet> GetRuleSet(const std::string& key);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -81,9 +75,10 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void InitDB(const base::FilePath& install_dir);
 
-  base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  HTTPSERecentlyUsedCache<HTTPSEHostRules> host_rules_cache_;
+  HTTPSERecentlyUsedCache<scoped_refptr<HTTPSERuleSet>> compiled_rules_cache_;
+  HTTPSERedirectCounter redirect_counter_;
   leveldb::DB* level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
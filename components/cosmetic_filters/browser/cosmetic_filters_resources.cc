@@ -5,6 +5,7 @@
 
 #include "brave/components/cosmetic_filters/browser/cosmetic_filters_resources.h"
 
+#include <iterator>
 #include <utility>
 
 #include "base/json/json_reader.h"
@@ -16,6 +17,27 @@
 
 namespace cosmetic_filters {
 
+namespace {
+
+// Custom filter selectors are hidden on first party content too, which the
+// renderer already handles for every selector it receives.
+std::vector<std::string> GetHiddenClassIdSelectors(
+    brave_shields::AdBlockService* ad_block_service,
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  std::vector<std::string> selectors;
+  std::vector<std::string> force_hide_selectors;
+  ad_block_service->HiddenClassIdSelectors(classes, ids, exceptions, &selectors,
+                                           &force_hide_selectors);
+  selectors.insert(selectors.end(),
+                   std::make_move_iterator(force_hide_selectors.begin()),
+                   std::make_move_iterator(force_hide_selectors.end()));
+  return selectors;
+}
+
+}  // namespace
+
 CosmeticFiltersResources::CosmeticFiltersResources(
     HostContentSettingsMap* settings_map,
     brave_shields::AdBlockService* ad_block_service)
@@ -32,13 +54,13 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
   absl::optional<base::Value> input_value = base::JSONReader::Read(input);
   if (!input_value || !input_value->is_dict()) {
     // Nothing to work with
-    std::move(callback).Run(base::Value());
+    std::move(callback).Run(std::vector<std::string>());
 
     return;
   }
   base::DictionaryValue* input_dict;
   if (!input_value->GetAsDictionary(&input_dict)) {
-    std::move(callback).Run(base::Value());
+    std::move(callback).Run(std::vector<std::string>());
 
     return;
   }
@@ -65,25 +87,25 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
 
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&brave_shields::AdBlockService::HiddenClassIdSelectors,
-                     base::Unretained(ad_block_service_), classes, ids,
-                     exceptions),
+      base::BindOnce(&GetHiddenClassIdSelectors,
+                     base::Unretained(ad_block_service_), std::move(classes),
+                     std::move(ids), exceptions),
       base::BindOnce(&CosmeticFiltersResources::HiddenClassIdSelectorsOnUI,
                      weak_factory_.GetWeakPtr(), std::move(callback)));
 }
 
 void CosmeticFiltersResources::HiddenClassIdSelectorsOnUI(
     HiddenClassIdSelectorsCallback callback,
-    absl::optional<base::Value> resources) {
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+    std::vector<std::string> selectors) {
+  std::move(callback).Run(std::move(selectors));
 }
 
 void CosmeticFiltersResources::UrlCosmeticResourcesOnUI(
     UrlCosmeticResourcesCallback callback,
-    absl::optional<base::Value> resources) {
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+    mojom::UrlSpecificResourcesPtr resources) {
+  if (!resources)
+    resources = mojom::UrlSpecificResources::New();
+  std::move(callback).Run(std::move(resources));
 }
 
 void CosmeticFiltersResources::ShouldDoCosmeticFiltering(
@@ -11,9 +11,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
-#include "base/values.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
 
 class HostContentSettingsMap;
 
@@ -54,10 +52,10 @@ class CosmeticFiltersResources final
 
  private:
   void HiddenClassIdSelectorsOnUI(HiddenClassIdSelectorsCallback callback,
-                                  absl::optional<base::Value> resources);
+                                  std::vector<std::string> selectors);
 
   void UrlCosmeticResourcesOnUI(UrlCosmeticResourcesCallback callback,
-                                absl::optional<base::Value> resources);
+                                mojom::UrlSpecificResourcesPtr resources);
 
   HostContentSettingsMap* settings_map_;             // Not owned
   brave_shields::AdBlockService* ad_block_service_;  // Not owned
@@ -5,10 +5,13 @@
 
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_handler.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
-#include "base/json/json_writer.h"
+#include "base/containers/flat_map.h"
+#include "base/json/string_escape.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -164,6 +167,33 @@ std::string LoadDataResource(const int id) {
   return std::string(resource_bundle.GetRawDataResource(id));
 }
 
+// Builds a JS array literal from |strings|.
+std::string ToJSArray(const std::vector<std::string>& strings) {
+  std::string result = "[";
+  for (const std::string& string : strings) {
+    if (result.size() > 1)
+      result += ',';
+    base::EscapeJSONString(string, true, &result);
+  }
+  result += ']';
+  return result;
+}
+
+// Builds a JS object literal mapping each selector to its array of styles.
+std::string ToJSObject(
+    const base::flat_map<std::string, std::vector<std::string>>& selectors) {
+  std::string result = "{";
+  for (const auto& selector : selectors) {
+    if (result.size() > 1)
+      result += ',';
+    base::EscapeJSONString(selector.first, true, &result);
+    result += ':';
+    result += ToJSArray(selector.second);
+  }
+  result += '}';
+  return result;
+}
+
 bool IsVettedSearchEngine(const GURL& url) {
   std::string domain_and_registry =
       net::registry_controlled_domains::GetDomainAndRegistry(
@@ -286,7 +316,7 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
 
 void CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
                                           base::OnceClosure callback) {
-  resources_dict_.reset();
+  resources_.reset();
   url_ = url;
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -314,25 +344,20 @@ void CosmeticFiltersJSHandler::OnShouldDoCosmeticFiltering(
 
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
-    base::Value result) {
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+    mojom::UrlSpecificResourcesPtr resources) {
+  resources_ = std::move(resources);
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
-  std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
-  }
-  if (!scriptlet_script.empty()) {
+  if (!resources_->injected_script.empty()) {
+    const std::string scriptlet_script = base::StringPrintf(
+        kScriptletInitScript,
+        base::GetQuotedJSONString(resources_->injected_script).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(scriptlet_script),
         blink::BackForwardCacheAware::kAllow);
@@ -342,11 +367,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -357,78 +380,46 @@ void CosmeticFiltersJSHandler::ApplyRules() {
       isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script),
       blink::BackForwardCacheAware::kAllow);
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const mojom::UrlSpecificResources& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetSize(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions.begin(),
+                     resources.exceptions.end());
 
-  if (hide_selectors_list && hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.hide_selectors.empty()) {
     // Building a script for stylesheet modifications
     std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+        base::StringPrintf(kHideSelectorsInjectScript,
+                           ToJSArray(resources.hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  if (force_hide_selectors_list && force_hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.force_hide_selectors.empty()) {
     // Building a script for stylesheet modifications
-    std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+    std::string new_selectors_script =
+        base::StringPrintf(kForceHideSelectorsInjectScript,
+                           ToJSArray(resources.force_hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-          blink::BackForwardCacheAware::kAllow);
-    }
-  }
+  std::string new_selectors_script =
+      base::StringPrintf(kStyleSelectorsInjectScript,
+                         ToJSObject(resources.style_selectors).c_str());
+  web_frame->ExecuteScriptInIsolatedWorld(
+      isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
+      blink::BackForwardCacheAware::kAllow);
 
   if (!enabled_1st_party_cf_) {
     web_frame->ExecuteScriptInIsolatedWorld(
@@ -437,29 +428,18 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
   }
 }
 
-void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(base::Value result) {
+void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
+    const std::vector<std::string>& selectors) {
   // If its a vetted engine AND we're not in aggressive
   // mode, don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
-  // We expect a List value from adblock service. That is
-  // an extra check to be sure that adblock file exist and gives us
-  // rules that we expect
-  base::ListValue* selectors_list;
-  if (!result.GetAsList(&selectors_list))
-    return;
-
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  std::string json_selectors;
-  if (!base::JSONWriter::Write(*selectors_list, &json_selectors) ||
-      json_selectors.empty()) {
-    json_selectors = "[]";
-  }
-  // Building a script for stylesheet modifications
-  std::string new_selectors_script =
-      base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-  if (selectors_list->GetSize() != 0) {
+  if (!selectors.empty()) {
+    // Building a script for stylesheet modifications
+    std::string new_selectors_script = base::StringPrintf(
+        kHideSelectorsInjectScript, ToJSArray(selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
@@ -6,7 +6,9 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +18,13 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -189,6 +193,64 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // the service exits
   return std::make_pair(extension, std::move(temp_dir));
 }
+
+void AppendFileContents(const base::FilePath& path, std::string* input) {
+  std::string contents;
+  base::ReadFileToString(path, &contents);
+  input->append(path.BaseName().AsUTF8Unsafe());
+  input->push_back('\0');
+  input->append(base::NumberToString(contents.size()));
+  input->push_back('\0');
+  input->append(contents);
+}
+
+// Hashes everything that goes into the extension converted from |rule|, so
+// an unchanged hash means the converted extension can be reused.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::string HashGreaselionRuleOnTaskRunner(
+    const greaselion::GreaselionRule& rule) {
+  std::string input = rule.name();
+  input.push_back('\0');
+  input.append(rule.run_at());
+  input.push_back('\0');
+  for (const auto& url_pattern : rule.url_patterns()) {
+    input.append(url_pattern);
+    input.push_back('\0');
+  }
+  for (const auto& script : rule.scripts())
+    AppendFileContents(script, &input);
+
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    for (const auto& message_file : message_files) {
+      base::FilePath relative_path;
+      rule.messages().AppendRelativePath(message_file, &relative_path);
+      input.append(relative_path.AsUTF8Unsafe());
+      AppendFileContents(message_file, &input);
+    }
+  }
+
+  return base::HexEncode(crypto::SHA256HashString(input).data(),
+                         crypto::kSHA256Length);
+}
+
+std::vector<std::string> HashGreaselionRulesOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules) {
+  std::vector<std::string> rule_hashes;
+  rule_hashes.reserve(rules.size());
+  for (const auto& rule : rules)
+    rule_hashes.push_back(HashGreaselionRuleOnTaskRunner(rule));
+  return rule_hashes;
+}
+
 }  // namespace
 
 namespace greaselion {
@@ -208,6 +270,7 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       update_in_progress_(false),
       update_pending_(false),
       pending_installs_(0),
+      pending_unloads_(0),
       task_runner_(std::move(task_runner)),
       browser_version_(
           version_info::GetBraveVersionWithoutChromiumMajorVersion()),
@@ -223,6 +286,17 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
   extension_registry_->RemoveObserver(this);
 }
 
+GreaselionServiceImpl::CachedExtension::CachedExtension() = default;
+
+GreaselionServiceImpl::CachedExtension::CachedExtension(
+    CachedExtension&& other) = default;
+
+GreaselionServiceImpl::CachedExtension&
+GreaselionServiceImpl::CachedExtension::operator=(CachedExtension&& other) =
+    default;
+
+GreaselionServiceImpl::CachedExtension::~CachedExtension() = default;
+
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
   return std::find(greaselion_extensions_.begin(), greaselion_extensions_.end(),
                    id) != greaselion_extensions_.end();
@@ -239,61 +313,152 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  std::set<std::string> rule_names;
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    rule_names.insert(rule->name());
+    if (rule->Matches(state_, browser_version_) &&
+        rule->has_unknown_preconditions() == false) {
+      rules.push_back(*rule);
+    }
+  }
+
+  // Hashing reads the rule files, so it runs on the extension file task
+  // runner, which was passed in in the constructor.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&HashGreaselionRulesOnTaskRunner, rules),
+      base::BindOnce(&GreaselionServiceImpl::OnRulesHashed,
+                     weak_factory_.GetWeakPtr(), std::move(rule_names),
+                     rules));
+}
+
+void GreaselionServiceImpl::OnRulesHashed(
+    std::set<std::string> rule_names,
+    std::vector<GreaselionRule> rules,
+    std::vector<std::string> rule_hashes) {
+  DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), rule_hashes.size());
+  std::map<std::string, std::string> matching_rule_hashes;
+  for (size_t i = 0; i < rules.size(); ++i)
+    matching_rule_hashes[rules[i].name()] = rule_hashes[i];
+  rule_names_to_install_ = std::move(rule_names);
+  rules_to_install_ = std::move(rules);
+  rule_hashes_to_install_ = std::move(rule_hashes);
+
+  // Only unload the installed extensions whose rule no longer matches or
+  // whose content changed. The others stay installed untouched.
+  std::vector<extensions::ExtensionId> extensions_to_unload;
+  for (const auto& cached_extension : extension_cache_) {
+    const extensions::ExtensionId& id =
+        cached_extension.second.converted_extension.first->id();
+    if (!IsGreaselionExtension(id))
+      continue;
+    auto it = matching_rule_hashes.find(cached_extension.first);
+    if (it == matching_rule_hashes.end() ||
+        it->second != cached_extension.second.rule_hash) {
+      extensions_to_unload.push_back(id);
+    }
+  }
+
+  if (extensions_to_unload.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  // OnExtensionUnloaded will be called on each extension, where we will update
+  // greaselion_extensions_. Once they are all unloaded, that callback will
+  // call CreateAndInstallExtensions().
+  pending_unloads_ = extensions_to_unload.size();
+  for (const auto& id : extensions_to_unload) {
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
   pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+  const std::set<std::string> rule_names = std::move(rule_names_to_install_);
+  const std::vector<GreaselionRule> rules = std::move(rules_to_install_);
+  const std::vector<std::string> rule_hashes =
+      std::move(rule_hashes_to_install_);
+
+  // Drop converted extensions of rules that were removed or changed. Those of
+  // rules that just stopped matching are kept for when they match again.
+  // Rule names are taken from the same snapshot as the matching rules, since
+  // the downloaded rules may have been replaced while hashing. Extensions
+  // that are still loaded are never dropped, as their files are in use and
+  // they have to be found again to be unloaded.
+  std::map<std::string, std::string> matching_rule_hashes;
+  for (size_t i = 0; i < rules.size(); ++i)
+    matching_rule_hashes[rules[i].name()] = rule_hashes[i];
+  for (auto it = extension_cache_.begin(); it != extension_cache_.end();) {
+    auto matching_rule_hash = matching_rule_hashes.find(it->first);
+    if (!IsGreaselionExtension(it->second.converted_extension.first->id()) &&
+        (!rule_names.count(it->first) ||
+         (matching_rule_hash != matching_rule_hashes.end() &&
+          matching_rule_hash->second != it->second.rule_hash))) {
+      // Deleting the directory is file IO, so do it on the task runner.
+      task_runner_->PostTask(
+          FROM_HERE,
+          base::BindOnce(base::DoNothing::Once<base::ScopedTempDir>(),
+                         std::move(it->second.converted_extension.second)));
+      it = extension_cache_.erase(it);
+    } else {
+      ++it;
     }
   }
+
+  std::vector<scoped_refptr<Extension>> extensions_to_install;
+  std::vector<size_t> rules_to_convert;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    auto it = extension_cache_.find(rules[i].name());
+    if (it == extension_cache_.end()) {
+      rules_to_convert.push_back(i);
+      continue;
+    }
+    DCHECK_EQ(it->second.rule_hash, rule_hashes[i]);
+    const scoped_refptr<Extension>& extension =
+        it->second.converted_extension.first;
+    if (!IsGreaselionExtension(extension->id()))
+      extensions_to_install.push_back(extension);
+  }
+
+  pending_installs_ = extensions_to_install.size() + rules_to_convert.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+
+  for (const scoped_refptr<Extension>& extension : extensions_to_install) {
+    greaselion_extensions_.push_back(extension->id());
+    extension_system_->ready().Post(
+        FROM_HERE,
+        base::BindOnce(&GreaselionServiceImpl::Install,
+                       weak_factory_.GetWeakPtr(), extension));
+  }
+
+  for (size_t i : rules_to_convert) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       rules[i], install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rules[i].name(),
+                       rule_hashes[i]));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_name,
+    const std::string& rule_hash,
     absl::optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -301,12 +466,15 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    scoped_refptr<Extension> extension = converted_extension->first;
+    greaselion_extensions_.push_back(extension->id());
+    CachedExtension& cached_extension = extension_cache_[rule_name];
+    cached_extension.rule_hash = rule_hash;
+    cached_extension.converted_extension = std::move(*converted_extension);
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+                                  std::move(extension)));
   }
 }
 
@@ -340,7 +508,7 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  if (update_in_progress_ && pending_unloads_ > 0 && --pending_unloads_ == 0) {
     // It's time!
     CreateAndInstallExtensions();
   }
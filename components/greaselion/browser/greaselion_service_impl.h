@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -68,9 +70,25 @@ class GreaselionServiceImpl : public GreaselionService {
       std::pair<scoped_refptr<extensions::Extension>, base::ScopedTempDir>;
 
  private:
+  // A converted extension kept for reuse while its rule is unchanged.
+  struct CachedExtension {
+    CachedExtension();
+    CachedExtension(CachedExtension&& other);
+    CachedExtension& operator=(CachedExtension&& other);
+    ~CachedExtension();
+
+    std::string rule_hash;
+    GreaselionConvertedExtension converted_extension;
+  };
+
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  void OnRulesHashed(std::set<std::string> rule_names,
+                     std::vector<GreaselionRule> rules,
+                     std::vector<std::string> rule_hashes);
   void CreateAndInstallExtensions();
   void PostConvert(
+      const std::string& rule_name,
+      const std::string& rule_hash,
       absl::optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -85,10 +103,18 @@ class GreaselionServiceImpl : public GreaselionService {
   bool update_in_progress_;
   bool update_pending_;
   int pending_installs_;
+  int pending_unloads_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Names of all downloaded rules, and the matching rules and their content
+  // hashes, as of the start of the update in progress.
+  std::set<std::string> rule_names_to_install_;
+  std::vector<GreaselionRule> rules_to_install_;
+  std::vector<std::string> rule_hashes_to_install_;
+  // Converted extensions by rule name. Only the latest conversion of each
+  // rule is kept, so toggling a feature back on doesn't convert again.
+  std::map<std::string, CachedExtension> extension_cache_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
@@ -25,11 +25,16 @@ namespace ntp_background_images {
 
 namespace {
 
-absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
+// Wallpapers are large so only the current and the next one, with their
+// logos, are kept in memory.
+constexpr size_t kMaxCachedImageFiles = 6;
+
+scoped_refptr<base::RefCountedMemory> ReadImageFileOnTaskRunner(
+    const base::FilePath& path) {
   std::string contents;
   if (!base::ReadFileToString(path, &contents))
-    return absl::optional<std::string>();
-  return contents;
+    return nullptr;
+  return base::RefCountedString::TakeString(&contents);
 }
 
 bool IsSuperReferralPath(const std::string& path) {
@@ -41,6 +46,7 @@ bool IsSuperReferralPath(const std::string& path) {
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
     : service_(service),
+      image_cache_(kMaxCachedImageFiles),
       weak_factory_(this) {
 }
 
@@ -94,28 +100,77 @@ void NTPBackgroundImagesSource::StartDataRequest(
   }
 
   GetImageFile(image_file_path, std::move(callback));
+
+  if (IsWallpaperPath(path))
+    PrefetchNextWallpaper(path);
 }
 
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  auto it = image_cache_.Get(image_file_path);
+  if (it != image_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  const bool is_pending = pending_reads_.count(image_file_path);
+  pending_reads_[image_file_path].push_back(std::move(callback));
+  if (!is_pending)
+    ReadImageFile(image_file_path);
+}
+
+void NTPBackgroundImagesSource::PrefetchImageFile(
+    const base::FilePath& image_file_path) {
+  if (image_file_path.empty() ||
+      image_cache_.Peek(image_file_path) != image_cache_.end() ||
+      pending_reads_.count(image_file_path)) {
+    return;
+  }
+
+  pending_reads_[image_file_path];
+  ReadImageFile(image_file_path);
+}
+
+void NTPBackgroundImagesSource::PrefetchNextWallpaper(const std::string& path) {
+  auto* images_data =
+      service_->GetBackgroundImagesData(IsSuperReferralPath(path));
+  if (!images_data || images_data->backgrounds.size() < 2)
+    return;
+
+  // ViewCounterModel shows the wallpapers in order, so the next new tab page
+  // with a branded wallpaper will request the following one.
+  const size_t next_index =
+      (GetWallpaperIndexFromPath(path) + 1) % images_data->backgrounds.size();
+  const auto& next_background = images_data->backgrounds[next_index];
+  PrefetchImageFile(next_background.image_file);
+  if (next_background.logo)
+    PrefetchImageFile(next_background.logo->image_file);
+}
+
+void NTPBackgroundImagesSource::ReadImageFile(
+    const base::FilePath& image_file_path) {
   base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadImageFileOnTaskRunner, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), image_file_path));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
-    GotDataCallback callback,
-    absl::optional<std::string> input) {
-  if (!input)
+    const base::FilePath& image_file_path,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes)
+    image_cache_.Put(image_file_path, bytes);
+
+  auto it = pending_reads_.find(image_file_path);
+  if (it == pending_reads_.end())
     return;
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+  std::vector<GotDataCallback> callbacks = std::move(it->second);
+  pending_reads_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -6,15 +6,15 @@
 #ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 
+#include <map>
 #include <string>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/url_data_source.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
-
-namespace base {
-class FilePath;
-}  // namespace base
 
 namespace ntp_background_images {
 
@@ -35,6 +35,7 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, CachedImageFile);
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -46,8 +47,12 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
 
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      absl::optional<std::string> input);
+  // Reads |image_file_path| into the image cache ahead of its request.
+  void PrefetchImageFile(const base::FilePath& image_file_path);
+  void PrefetchNextWallpaper(const std::string& path);
+  void ReadImageFile(const base::FilePath& image_file_path);
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      scoped_refptr<base::RefCountedMemory> bytes);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -58,6 +63,14 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
+  // Recently served or prefetched image files, keyed by file path. Component
+  // updates install to a new versioned directory so stale entries are never
+  // hit and just age out.
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_cache_;
+  // Callbacks waiting on an in-flight read, keyed by file path. A prefetch
+  // has no callbacks.
+  std::map<base::FilePath, std::vector<GotDataCallback>> pending_reads_;
   base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
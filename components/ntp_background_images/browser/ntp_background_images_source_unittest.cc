@@ -6,6 +6,11 @@
 #include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -32,7 +37,7 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -78,6 +83,39 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, CachedImageFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath image_file_path =
+      temp_dir.GetPath().AppendASCII("wallpaper.jpg");
+  ASSERT_TRUE(base::WriteFile(image_file_path, "image"));
+
+  std::string data;
+  auto get_image_file = [&]() {
+    base::RunLoop run_loop;
+    source_->GetImageFile(
+        image_file_path,
+        base::BindOnce(
+            [](std::string* data, base::OnceClosure quit_closure,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              *data = bytes ? std::string(bytes->front_as<char>(),
+                                          bytes->size())
+                            : std::string();
+              std::move(quit_closure).Run();
+            },
+            &data, run_loop.QuitClosure()));
+    run_loop.Run();
+  };
+
+  get_image_file();
+  EXPECT_EQ("image", data);
+
+  // Served from memory once read.
+  ASSERT_TRUE(base::DeleteFile(image_file_path));
+  get_image_file();
+  EXPECT_EQ("image", data);
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
@@ -45,6 +45,12 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   // The API
   bool IsWhitelisted(const GURL& url);
   std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  // The returned rewriter hands every output chunk to |output_sink| as soon
+  // as it is produced instead of accumulating it.
+  std::unique_ptr<Rewriter> MakeStreamingRewriter(
+      const GURL& url,
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data);
   const std::string& GetContentStylesheet();
 
  private:
@@ -12,6 +12,7 @@
 
 class PrefRegistrySimple;
 class PrefService;
+class WeeklyStorage;
 
 namespace speedreader {
 
@@ -32,6 +33,8 @@ class SpeedreaderService : public KeyedService {
 
  private:
   PrefService* prefs_ = nullptr;
+  // Loaded once, since IsEnabled() records the toggle count on every call.
+  std::unique_ptr<WeeklyStorage> weekly_toggles_;
 };
 
 }  // namespace speedreader
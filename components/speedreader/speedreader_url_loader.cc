@@ -11,8 +11,11 @@
 
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/sequenced_task_runner.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
@@ -25,8 +28,120 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinimumDistilledLength = 1024;
+
+// Source chunks posted to the rewriter and not yet processed. Reading from the
+// source pauses at this limit, the same way the destination pipe capacity
+// bounds the pass-through path.
+constexpr size_t kMaxPendingDistillChunks = 4;
+
+SpeedReaderURLLoader::RewriterFactory& GetRewriterFactoryForTesting() {
+  static base::NoDestructor<SpeedReaderURLLoader::RewriterFactory> factory;
+  return *factory;
+}
+
+class SpeedreaderStreamingRewriter
+    : public SpeedReaderURLLoader::StreamingRewriter {
+ public:
+  explicit SpeedreaderStreamingRewriter(std::unique_ptr<Rewriter> rewriter)
+      : rewriter_(std::move(rewriter)) {}
+  ~SpeedreaderStreamingRewriter() override = default;
+
+  int Write(const char* chunk, size_t chunk_len) override {
+    return rewriter_->Write(chunk, chunk_len);
+  }
+
+  int End() override { return rewriter_->End(); }
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+};
+
 }  // namespace
 
+// Owns the rewriter and runs it on the distill task runner. Every output
+// chunk and the result of the rewriting are posted back to the loader.
+class SpeedReaderURLLoader::Distiller {
+ public:
+  Distiller(scoped_refptr<base::SingleThreadTaskRunner> loader_task_runner,
+            base::WeakPtr<SpeedReaderURLLoader> loader)
+      : loader_task_runner_(std::move(loader_task_runner)),
+        loader_(std::move(loader)) {}
+
+  ~Distiller() = default;
+
+  Distiller(const Distiller&) = delete;
+  Distiller& operator=(const Distiller&) = delete;
+
+  // Must be called on the loader sequence, before any other method.
+  void Init(SpeedreaderRewriterService* rewriter_service, const GURL& url) {
+    const RewriterFactory& factory = GetRewriterFactoryForTesting();
+    if (factory) {
+      rewriter_ = factory.Run(&Distiller::OnOutput, this);
+      return;
+    }
+    rewriter_ = std::make_unique<SpeedreaderStreamingRewriter>(
+        rewriter_service->MakeStreamingRewriter(url, &Distiller::OnOutput,
+                                                this));
+  }
+
+  void Write(std::string chunk) {
+    if (!failed_) {
+      const base::TimeTicks start_time = base::TimeTicks::Now();
+      const int result = rewriter_->Write(chunk.data(), chunk.length());
+      distill_time_ += base::TimeTicks::Now() - start_time;
+      if (result != 0) {
+        failed_ = true;
+        loader_task_runner_->PostTask(
+            FROM_HERE,
+            base::BindOnce(&SpeedReaderURLLoader::OnDistillFailed, loader_));
+      }
+    }
+
+    loader_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&SpeedReaderURLLoader::OnChunkDistilled, loader_));
+  }
+
+  void End() {
+    if (failed_)
+      return;
+
+    const base::TimeTicks start_time = base::TimeTicks::Now();
+    rewriter_->End();
+    distill_time_ += base::TimeTicks::Now() - start_time;
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", distill_time_);
+
+    loader_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&SpeedReaderURLLoader::OnDistillEnded, loader_));
+  }
+
+ private:
+  static void OnOutput(const char* chunk, size_t chunk_len, void* user_data) {
+    Distiller* distiller = static_cast<Distiller*>(user_data);
+    distiller->loader_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&SpeedReaderURLLoader::OnDistilledOutput,
+                                  distiller->loader_,
+                                  std::string(chunk, chunk_len)));
+  }
+
+  scoped_refptr<base::SingleThreadTaskRunner> loader_task_runner_;
+  base::WeakPtr<SpeedReaderURLLoader> loader_;
+  std::unique_ptr<StreamingRewriter> rewriter_;
+  bool failed_ = false;
+  // Time spent in the rewriter, summed over all chunks.
+  base::TimeDelta distill_time_;
+};
+
+// static
+void SpeedReaderURLLoader::SetRewriterFactoryForTesting(
+    RewriterFactory factory) {
+  GetRewriterFactoryForTesting() = std::move(factory);
+}
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -69,6 +184,7 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(nullptr)),
       rewriter_service_(rewriter_service) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
@@ -121,7 +237,20 @@ void SpeedReaderURLLoader::OnTransferSizeUpdated(int32_t transfer_size_diff) {
 void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
+  if (!throttle_ || (!rewriter_service_ && !GetRewriterFactoryForTesting())) {
+    Abort();
+    return;
+  }
+
   state_ = State::kLoading;
+  // Offload heavy distilling to another sequence.
+  distill_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_BLOCKING});
+  distiller_ = std::unique_ptr<Distiller, base::OnTaskRunnerDeleter>(
+      new Distiller(task_runner_, weak_factory_.GetWeakPtr()),
+      base::OnTaskRunnerDeleter(distill_task_runner_));
+  distiller_->Init(rewriter_service_, response_url_);
+
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -192,20 +321,26 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
-  DCHECK_EQ(State::kLoading, state_);
+  DCHECK(state_ == State::kLoading || state_ == State::kSending);
 
-  size_t start_size = buffered_body_.size();
+  std::string chunk(kReadBufferSize, '\0');
   uint32_t read_bytes = kReadBufferSize;
-  buffered_body_.resize(start_size + read_bytes);
   MojoResult result = body_consumer_handle_->ReadData(
-      &buffered_body_[0] + start_size, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
-      buffered_body_.resize(start_size);
-      MaybeLaunchSpeedreader();
+      source_complete_ = true;
+      body_consumer_watcher_.Cancel();
+      if (distiller_) {
+        distill_task_runner_->PostTask(
+            FROM_HERE, base::BindOnce(&Distiller::End,
+                                      base::Unretained(distiller_.get())));
+        return;
+      }
+      MaybeCompleteSending();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
       body_consumer_watcher_.ArmOrNotify();
@@ -216,81 +351,152 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   }
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
-  buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  chunk.resize(read_bytes);
+
+  if (state_ == State::kSending && !distilled_) {
+    // Not readable, pass the body through. Reading resumes once the
+    // destination has taken all of it.
+    output_buffer_.append(chunk);
+    SendReceivedBodyToClient();
+    return;
+  }
 
+  DCHECK(distiller_);
+  if (state_ == State::kLoading)
+    buffered_body_.append(chunk);
+  ++pending_distill_chunks_;
+  distill_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Distiller::Write, base::Unretained(distiller_.get()),
+                     std::move(chunk)));
+
+  if (pending_distill_chunks_ >= kMaxPendingDistillChunks) {
+    // The rewriter is behind, reading resumes in OnChunkDistilled().
+    waiting_for_distiller_ = true;
+    return;
+  }
   body_consumer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
-  if (bytes_remaining_in_buffer_ > 0) {
+  if (output_offset_ < output_buffer_.size()) {
     SendReceivedBodyToClient();
-  } else {
-    CompleteSending();
+    return;
   }
-}
 
-void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
-  DCHECK_EQ(State::kLoading, state_);
-  if (!throttle_ || !rewriter_service_) {
-    Abort();
+  if (!distilled_ && !source_complete_) {
+    body_consumer_watcher_.ArmOrNotify();
     return;
   }
 
-  VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
-  bytes_remaining_in_buffer_ = buffered_body_.size();
-
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
-    base::ThreadPool::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
-                       weak_factory_.GetWeakPtr()));
+  MaybeCompleteSending();
+}
+
+void SpeedReaderURLLoader::OnDistilledOutput(std::string chunk) {
+  switch (state_) {
+    case State::kLoading:
+      distilled_body_.append(chunk);
+      if (distilled_body_.size() >= kMinimumDistilledLength) {
+        // There is no rewriter service when a test rewriter is used.
+        std::string body =
+            rewriter_service_ ? rewriter_service_->GetContentStylesheet()
+                              : std::string();
+        body.append(distilled_body_);
+        CommitOutput(std::move(body), /* distilled */ true);
+      }
+      return;
+    case State::kSending:
+      DCHECK(distilled_);
+      output_buffer_.append(chunk);
+      SendReceivedBodyToClient();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+      NOTREACHED();
+      return;
+    case State::kAborted:
+      return;
+  }
+  NOTREACHED();
+}
+
+void SpeedReaderURLLoader::OnChunkDistilled() {
+  // Once distilling has stopped, reading is driven by the destination.
+  if (!distiller_)
     return;
+
+  DCHECK_GT(pending_distill_chunks_, 0u);
+  --pending_distill_chunks_;
+  if (waiting_for_distiller_) {
+    waiting_for_distiller_ = false;
+    body_consumer_watcher_.ArmOrNotify();
   }
-  CompleteLoading(std::move(buffered_body_));
 }
 
-void SpeedReaderURLLoader::CompleteLoading(std::string body) {
+void SpeedReaderURLLoader::OnDistillFailed() {
+  VLOG(2) << __func__ << " " << response_url_;
+  StopDistilling();
+  switch (state_) {
+    case State::kLoading:
+      // Fall back to the original body, including whatever is still to come.
+      CommitOutput(std::move(buffered_body_), /* distilled */ false);
+      return;
+    case State::kSending:
+      // Part of the distilled page has already been sent, so finish with
+      // what the rewriter has produced.
+      DCHECK(distilled_);
+      body_consumer_watcher_.Cancel();
+      source_complete_ = true;
+      MaybeCompleteSending();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+      NOTREACHED();
+      return;
+    case State::kAborted:
+      return;
+  }
+  NOTREACHED();
+}
+
+void SpeedReaderURLLoader::OnDistillEnded() {
+  StopDistilling();
+  switch (state_) {
+    case State::kLoading:
+      // Not enough output, the page is not readable.
+      VLOG(2) << __func__ << " distilled body too short";
+      CommitOutput(std::move(buffered_body_), /* distilled */ false);
+      return;
+    case State::kSending:
+      MaybeCompleteSending();
+      return;
+    case State::kWaitForBody:
+    case State::kCompleted:
+      NOTREACHED();
+      return;
+    case State::kAborted:
+      return;
+  }
+  NOTREACHED();
+}
+
+void SpeedReaderURLLoader::CommitOutput(std::string body, bool distilled) {
   DCHECK_EQ(State::kLoading, state_);
+  VLOG(2) << __func__ << " distilled = " << distilled
+          << " committed size = " << body.size();
   state_ = State::kSending;
+  distilled_ = distilled;
+  std::string().swap(buffered_body_);
+  std::string().swap(distilled_body_);
 
   if (!throttle_) {
     Abort();
     return;
   }
 
-  buffered_body_ = std::move(body);
-  bytes_remaining_in_buffer_ = buffered_body_.size();
+  output_buffer_ = std::move(body);
+  output_offset_ = 0;
 
   throttle_->Resume();
   mojo::ScopedDataPipeConsumerHandle body_to_send;
@@ -311,12 +517,28 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
 
-  DCHECK(bytes_remaining_in_buffer_);
-  if (bytes_remaining_in_buffer_) {
+  if (!output_buffer_.empty()) {
     SendReceivedBodyToClient();
     return;
   }
 
+  MaybeCompleteSending();
+}
+
+void SpeedReaderURLLoader::StopDistilling() {
+  // Any chunks already posted run before the distiller is deleted.
+  distiller_.reset();
+  pending_distill_chunks_ = 0;
+  waiting_for_distiller_ = false;
+}
+
+void SpeedReaderURLLoader::MaybeCompleteSending() {
+  if (state_ != State::kSending)
+    return;
+  if (output_offset_ < output_buffer_.size() || !source_complete_ ||
+      distiller_) {
+    return;
+  }
   CompleteSending();
 }
 
@@ -336,12 +558,10 @@ void SpeedReaderURLLoader::CompleteSending() {
 
 void SpeedReaderURLLoader::SendReceivedBodyToClient() {
   DCHECK_EQ(State::kSending, state_);
-  // Send the buffered data first.
-  DCHECK_GT(bytes_remaining_in_buffer_, 0u);
-  size_t start_position = buffered_body_.size() - bytes_remaining_in_buffer_;
-  uint32_t bytes_sent = bytes_remaining_in_buffer_;
+  DCHECK_LT(output_offset_, output_buffer_.size());
+  uint32_t bytes_sent = output_buffer_.size() - output_offset_;
   MojoResult result =
-      body_producer_handle_->WriteData(buffered_body_.data() + start_position,
+      body_producer_handle_->WriteData(output_buffer_.data() + output_offset_,
                                        &bytes_sent, MOJO_WRITE_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
@@ -358,13 +578,18 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       NOTREACHED();
       return;
   }
-  bytes_remaining_in_buffer_ -= bytes_sent;
+  output_offset_ += bytes_sent;
+  if (output_offset_ == output_buffer_.size()) {
+    output_buffer_.clear();
+    output_offset_ = 0;
+  }
   body_producer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
+  StopDistilling();
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
   source_url_loader_.reset();
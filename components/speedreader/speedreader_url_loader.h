@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -29,8 +31,13 @@ namespace speedreader {
 class SpeedReaderThrottle;
 class SpeedreaderRewriterService;
 
-// Loads the whole response body and tries to Speedreader-distill it.
-// Cargoculted from |`SniffingURLLoader|.
+// Streams the response body through a Speedreader rewriter and forwards the
+// distilled page, or the original body if the page turns out not to be
+// readable. Cargoculted from |`SniffingURLLoader|.
+//
+// Body chunks are handed to the rewriter on a worker sequence as they arrive,
+// so distilling overlaps with the download. The rewriter output is streamed
+// back to this loader.
 //
 // This loader has five states:
 // kWaitForBody: The initial state until the body is received (=
@@ -38,14 +45,21 @@ class SpeedreaderRewriterService;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
-//            done, this loader will dispatch queued messages like
-//            OnStartLoadingResponseBody() to the destination
-//            loader client, and then the state is changed to kSending.
-// kSending: Receives the body and sends it to the destination loader client.
-//           The state changes to kCompleted after all data is sent.
+// kLoading: Receives the body from the source loader and feeds it to the
+//           rewriter. Nothing has been sent to the destination yet and the
+//           original body is kept as a fallback. Once the rewriter has
+//           produced enough output to consider the page readable, the
+//           distilled output is committed. If the rewriter fails, or ends
+//           without enough output, the original body is committed instead.
+//           Reading from the source pauses while the rewriter has a few
+//           chunks queued. On commit this loader dispatches
+//           OnStartLoadingResponseBody() to the destination loader client and
+//           the state is changed to kSending.
+// kSending: Sends the committed output to the destination loader client while
+//           the source body and the rewriter output keep streaming in. Reading
+//           from the source is paused while the destination pipe is full, or
+//           while the rewriter is behind for the distilled page. The state
+//           changes to kCompleted after all data is sent.
 // kCompleted: All data has been sent to the destination loader.
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
@@ -53,6 +67,27 @@ class SpeedreaderRewriterService;
 class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                              public network::mojom::URLLoader {
  public:
+  // The rewriter the response body is streamed through. Write() and End()
+  // return non-zero on failure, like Rewriter.
+  class StreamingRewriter {
+   public:
+    virtual ~StreamingRewriter() = default;
+    virtual int Write(const char* chunk, size_t chunk_len) = 0;
+    virtual int End() = 0;
+  };
+
+  // Makes a rewriter that hands every output chunk to the sink, called with
+  // the given user data.
+  using RewriterFactory =
+      base::RepeatingCallback<std::unique_ptr<StreamingRewriter>(
+          void (*)(const char*, size_t, void*),
+          void*)>;
+
+  // Loaders that start receiving the body afterwards use rewriters made by
+  // |factory| instead of the rewriter service, which may then be null. Pass
+  // a null callback to restore the default.
+  static void SetRewriterFactoryForTesting(RewriterFactory factory);
+
   ~SpeedReaderURLLoader() override;
 
   SpeedReaderURLLoader(const SpeedReaderURLLoader&) = delete;
@@ -111,12 +146,23 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void PauseReadingBodyFromNet() override;
   void ResumeReadingBodyFromNet() override;
 
+  class Distiller;
+
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
-  void MaybeLaunchSpeedreader();
 
-  // Gets either distilled or untouched body.
-  void CompleteLoading(std::string body);
+  // Called with the rewriter results, in the order they were produced.
+  void OnDistilledOutput(std::string chunk);
+  // Called after each source chunk has gone through the rewriter.
+  void OnChunkDistilled();
+  void OnDistillFailed();
+  void OnDistillEnded();
+
+  // Starts sending |body| to the destination, followed by either the rest of
+  // the distilled output or the rest of the source body.
+  void CommitOutput(std::string body, bool distilled);
+  void StopDistilling();
+  void MaybeCompleteSending();
   void CompleteSending();
   void SendReceivedBodyToClient();
 
@@ -139,9 +185,30 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   // Set if OnComplete() is called during distilling.
   absl::optional<network::URLLoaderCompletionStatus> complete_status_;
 
-  // Note that this could be replaced by a distilled version.
+  // Runs the rewriter. Tasks for the distiller are posted to
+  // |distill_task_runner_| and it is destroyed there, after any pending
+  // chunks.
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<Distiller, base::OnTaskRunnerDeleter> distiller_;
+  // Source chunks posted to |distiller_| that it has not processed yet.
+  size_t pending_distill_chunks_ = 0;
+  // Set while reading from the source waits for |distiller_| to catch up.
+  bool waiting_for_distiller_ = false;
+
+  // Whether the committed output is the distilled page.
+  bool distilled_ = false;
+  // Set once all of the source body has been read.
+  bool source_complete_ = false;
+
+  // Source body kept until the output is committed, for the fallback.
   std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  // Distilled output received before the output is committed.
+  std::string distilled_body_;
+
+  // Committed output not yet written to |body_producer_handle_|, starting
+  // at |output_offset_|.
+  std::string output_buffer_;
+  size_t output_offset_ = 0;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
@@ -0,0 +1,353 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_url_loader.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "brave/components/speedreader/speedreader_throttle.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "services/network/test/test_url_loader_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/common/loader/url_loader_throttle.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kTestUrl[] = "https://brave.com/some/article";
+
+// Distilled output is recognizable as runs of 'd'.
+constexpr char kDistilledChar = 'd';
+
+constexpr size_t kNeverFail = 0;
+constexpr size_t kUnlimitedOutput = std::numeric_limits<size_t>::max();
+
+using OutputSink = void (*)(const char*, size_t, void*);
+
+// Turns every chunk into as many distilled characters, up to |max_output| in
+// total. The |fail_on_write|-th write fails, counting from 1.
+class FakeRewriter : public SpeedReaderURLLoader::StreamingRewriter {
+ public:
+  FakeRewriter(OutputSink output_sink,
+               void* output_sink_user_data,
+               size_t fail_on_write,
+               size_t max_output)
+      : output_sink_(output_sink),
+        output_sink_user_data_(output_sink_user_data),
+        fail_on_write_(fail_on_write),
+        max_output_(max_output) {}
+  ~FakeRewriter() override = default;
+
+  FakeRewriter(const FakeRewriter&) = delete;
+  FakeRewriter& operator=(const FakeRewriter&) = delete;
+
+  int Write(const char* chunk, size_t chunk_len) override {
+    if (++writes_ == fail_on_write_)
+      return 1;
+
+    const size_t length = std::min(chunk_len, max_output_ - output_size_);
+    if (length == 0)
+      return 0;
+    output_size_ += length;
+    const std::string output(length, kDistilledChar);
+    output_sink_(output.data(), output.size(), output_sink_user_data_);
+    return 0;
+  }
+
+  int End() override { return 0; }
+
+ private:
+  OutputSink output_sink_;
+  void* output_sink_user_data_;
+  size_t fail_on_write_;
+  size_t max_output_;
+  size_t writes_ = 0;
+  size_t output_size_ = 0;
+};
+
+// Connects the throttle to a test client, in place of the navigation.
+class MockDelegate : public blink::URLLoaderThrottle::Delegate {
+ public:
+  MockDelegate() = default;
+  ~MockDelegate() override = default;
+
+  MockDelegate(const MockDelegate&) = delete;
+  MockDelegate& operator=(const MockDelegate&) = delete;
+
+  // blink::URLLoaderThrottle::Delegate
+  void CancelWithError(int error_code,
+                       base::StringPiece custom_reason) override {
+    ADD_FAILURE() << "Unexpected error " << error_code;
+  }
+
+  void Resume() override { is_resumed_ = true; }
+
+  void InterceptResponse(
+      mojo::PendingRemote<network::mojom::URLLoader> new_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>
+          new_client_receiver,
+      mojo::PendingRemote<network::mojom::URLLoader>* original_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>*
+          original_client_receiver) override {
+    destination_loader_remote_.Bind(std::move(new_loader));
+    ASSERT_TRUE(mojo::FusePipes(std::move(new_client_receiver),
+                                destination_client_.CreateRemote()));
+    source_loader_receiver_ = original_loader->InitWithNewPipeAndPassReceiver();
+    *original_client_receiver =
+        source_client_remote_.BindNewPipeAndPassReceiver();
+  }
+
+  bool is_resumed() const { return is_resumed_; }
+
+  network::mojom::URLLoaderClient* source_client() {
+    return source_client_remote_.get();
+  }
+
+  network::TestURLLoaderClient* destination_client() {
+    return &destination_client_;
+  }
+
+ private:
+  bool is_resumed_ = false;
+
+  mojo::Remote<network::mojom::URLLoader> destination_loader_remote_;
+  network::TestURLLoaderClient destination_client_;
+
+  mojo::PendingReceiver<network::mojom::URLLoader> source_loader_receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> source_client_remote_;
+};
+
+// A body that is not made of the distilled character and shows reordering.
+std::string MakeBody(size_t size) {
+  std::string body(size, '\0');
+  for (size_t i = 0; i < size; ++i)
+    body[i] = 'a' + i % 26;
+  return body;
+}
+
+}  // namespace
+
+class SpeedReaderURLLoaderTest : public testing::Test {
+ public:
+  SpeedReaderURLLoaderTest() = default;
+  ~SpeedReaderURLLoaderTest() override = default;
+  SpeedReaderURLLoaderTest(const SpeedReaderURLLoaderTest&) = delete;
+  SpeedReaderURLLoaderTest& operator=(const SpeedReaderURLLoaderTest&) =
+      delete;
+
+  void TearDown() override {
+    SpeedReaderURLLoader::SetRewriterFactoryForTesting(
+        SpeedReaderURLLoader::RewriterFactory());
+  }
+
+  void SetRewriter(size_t fail_on_write, size_t max_output) {
+    SpeedReaderURLLoader::SetRewriterFactoryForTesting(base::BindRepeating(
+        [](size_t fail_on_write, size_t max_output, OutputSink output_sink,
+           void* output_sink_user_data)
+            -> std::unique_ptr<SpeedReaderURLLoader::StreamingRewriter> {
+          return std::make_unique<FakeRewriter>(
+              output_sink, output_sink_user_data, fail_on_write, max_output);
+        },
+        fail_on_write, max_output));
+  }
+
+  // Intercepts the response and starts loading a body of up to
+  // |source_capacity| bytes.
+  void StartLoading(uint32_t source_capacity) {
+    throttle_ = std::make_unique<SpeedReaderThrottle>(
+        nullptr, base::ThreadTaskRunnerHandle::Get());
+    throttle_->set_delegate(&delegate_);
+
+    auto response_head = network::mojom::URLResponseHead::New();
+    bool defer = false;
+    throttle_->WillProcessResponse(GURL(kTestUrl), response_head.get(),
+                                   &defer);
+    EXPECT_TRUE(defer);
+
+    MojoCreateDataPipeOptions options;
+    options.struct_size = sizeof(MojoCreateDataPipeOptions);
+    options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+    options.element_num_bytes = 1;
+    options.capacity_num_bytes = source_capacity;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    ASSERT_EQ(MOJO_RESULT_OK,
+              mojo::CreateDataPipe(&options, source_producer_, consumer));
+    delegate_.source_client()->OnStartLoadingResponseBody(std::move(consumer));
+    task_environment_.RunUntilIdle();
+  }
+
+  void WriteSourceBody(const std::string& data) {
+    uint32_t size = data.size();
+    ASSERT_EQ(MOJO_RESULT_OK,
+              source_producer_->WriteData(data.data(), &size,
+                                          MOJO_WRITE_DATA_FLAG_ALL_OR_NONE));
+    task_environment_.RunUntilIdle();
+  }
+
+  void CompleteSource() {
+    source_producer_.reset();
+    delegate_.source_client()->OnComplete(
+        network::URLLoaderCompletionStatus(net::OK));
+    task_environment_.RunUntilIdle();
+  }
+
+  // Reads the destination body until the loader closes the pipe.
+  std::string ReadDestinationBody() {
+    std::string body;
+    mojo::DataPipeConsumerHandle handle =
+        destination_client()->response_body();
+    EXPECT_TRUE(handle.is_valid());
+    bool waited = false;
+    while (handle.is_valid()) {
+      char buffer[4096];
+      uint32_t read_bytes = sizeof(buffer);
+      const MojoResult result =
+          handle.ReadData(buffer, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        if (waited) {
+          ADD_FAILURE() << "The loader stopped sending the body";
+          break;
+        }
+        waited = true;
+        task_environment_.RunUntilIdle();
+        continue;
+      }
+      if (result != MOJO_RESULT_OK)
+        break;
+      waited = false;
+      body.append(buffer, read_bytes);
+    }
+    return body;
+  }
+
+  bool is_resumed() const { return delegate_.is_resumed(); }
+
+  network::TestURLLoaderClient* destination_client() {
+    return delegate_.destination_client();
+  }
+
+  mojo::DataPipeProducerHandle source_producer() {
+    return source_producer_.get();
+  }
+
+ private:
+  base::test::TaskEnvironment task_environment_;
+  MockDelegate delegate_;
+  std::unique_ptr<SpeedReaderThrottle> throttle_;
+  mojo::ScopedDataPipeProducerHandle source_producer_;
+};
+
+TEST_F(SpeedReaderURLLoaderTest, CommitDistilledOutputPastThreshold) {
+  SetRewriter(kNeverFail, kUnlimitedOutput);
+  StartLoading(64 * 1024);
+
+  // Not enough distilled output to tell if the page is readable.
+  WriteSourceBody(MakeBody(512));
+  EXPECT_FALSE(is_resumed());
+
+  WriteSourceBody(MakeBody(1024));
+  EXPECT_TRUE(is_resumed());
+
+  CompleteSource();
+  EXPECT_EQ(std::string(1536, kDistilledChar), ReadDestinationBody());
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+TEST_F(SpeedReaderURLLoaderTest, FallBackIfRewriterFailsBeforeCommit) {
+  SetRewriter(/* fail_on_write */ 1, kUnlimitedOutput);
+  StartLoading(64 * 1024);
+
+  const std::string body = MakeBody(4096);
+  WriteSourceBody(body);
+  EXPECT_TRUE(is_resumed());
+
+  CompleteSource();
+  EXPECT_EQ(body, ReadDestinationBody());
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+TEST_F(SpeedReaderURLLoaderTest, FallBackIfDistilledOutputIsTooShort) {
+  SetRewriter(kNeverFail, /* max_output */ 100);
+  StartLoading(64 * 1024);
+
+  const std::string body = MakeBody(4096);
+  WriteSourceBody(body);
+  EXPECT_FALSE(is_resumed());
+
+  CompleteSource();
+  EXPECT_TRUE(is_resumed());
+  EXPECT_EQ(body, ReadDestinationBody());
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+TEST_F(SpeedReaderURLLoaderTest, FinishDistilledOutputIfRewriterFailsLater) {
+  SetRewriter(/* fail_on_write */ 2, kUnlimitedOutput);
+  StartLoading(64 * 1024);
+
+  WriteSourceBody(MakeBody(2048));
+  EXPECT_TRUE(is_resumed());
+
+  // The distilled page is already being sent, so the original body can no
+  // longer be used.
+  WriteSourceBody(MakeBody(2048));
+  EXPECT_EQ(std::string(2048, kDistilledChar), ReadDestinationBody());
+
+  CompleteSource();
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+TEST_F(SpeedReaderURLLoaderTest, PassThroughWaitsForDestination) {
+  SetRewriter(/* fail_on_write */ 1, kUnlimitedOutput);
+  const std::string body = MakeBody(4 * 1024 * 1024);
+  StartLoading(body.size());
+
+  // Nothing reads the destination pipe, so the loader must stop reading the
+  // source well before its end instead of buffering it.
+  WriteSourceBody(body);
+  EXPECT_TRUE(is_resumed());
+  uint32_t size = body.size() / 2;
+  EXPECT_EQ(MOJO_RESULT_OUT_OF_RANGE,
+            source_producer().WriteData(body.data(), &size,
+                                        MOJO_WRITE_DATA_FLAG_ALL_OR_NONE));
+
+  CompleteSource();
+  EXPECT_EQ(body, ReadDestinationBody());
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+TEST_F(SpeedReaderURLLoaderTest, DistillBodyLargerThanPendingChunks) {
+  SetRewriter(kNeverFail, kUnlimitedOutput);
+  const std::string body = MakeBody(1024 * 1024);
+  StartLoading(body.size());
+
+  // Reading pauses and resumes as the rewriter catches up.
+  WriteSourceBody(body);
+  CompleteSource();
+  EXPECT_EQ(std::string(body.size(), kDistilledChar), ReadDestinationBody());
+  ASSERT_TRUE(destination_client()->has_received_completion());
+  EXPECT_EQ(net::OK, destination_client()->completion_status().error_code);
+}
+
+}  // namespace speedreader
@@ -42,7 +42,7 @@ WeeklyStorage::~WeeklyStorage() = default;
 void WeeklyStorage::AddDelta(uint64_t delta) {
   FilterToWeek();
   daily_values_.front().value += delta;
-  Save();
+  OnChanged();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
@@ -51,7 +51,7 @@ void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  OnChanged();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
@@ -98,6 +98,26 @@ bool WeeklyStorage::IsOneWeekPassed() const {
   return daily_values_.size() == kDaysInWeek;
 }
 
+void WeeklyStorage::SetDeferredSaveCallback(base::RepeatingClosure callback) {
+  deferred_save_callback_ = std::move(callback);
+}
+
+void WeeklyStorage::SaveIfNeeded() {
+  if (!is_dirty_)
+    return;
+  is_dirty_ = false;
+  Save();
+}
+
+void WeeklyStorage::OnChanged() {
+  if (!deferred_save_callback_) {
+    Save();
+    return;
+  }
+  is_dirty_ = true;
+  deferred_save_callback_.Run();
+}
+
 void WeeklyStorage::FilterToWeek() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
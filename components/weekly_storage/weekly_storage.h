@@ -9,6 +9,7 @@
 #include <list>
 #include <memory>
 
+#include "base/callback.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -41,6 +42,11 @@ class WeeklyStorage {
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
 
+  // Once set, changes are only kept in memory and |callback| is run instead
+  // of writing the pref. The owner persists them with |SaveIfNeeded|.
+  void SetDeferredSaveCallback(base::RepeatingClosure callback);
+  void SaveIfNeeded();
+
  private:
   struct DailyValue {
     base::Time day;
@@ -49,12 +55,16 @@ class WeeklyStorage {
   void FilterToWeek();
   void Load();
   void Save();
+  void OnChanged();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
   std::list<DailyValue> daily_values_;
+
+  base::RepeatingClosure deferred_save_callback_;
+  bool is_dirty_ = false;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -0,0 +1,48 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+
+namespace {
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(30);
+}
+
+WeeklyStorageRegistry::WeeklyStorageRegistry(PrefService* prefs)
+    : prefs_(prefs) {
+  DCHECK(prefs);
+}
+
+WeeklyStorageRegistry::~WeeklyStorageRegistry() {
+  Flush();
+}
+
+WeeklyStorage* WeeklyStorageRegistry::Get(const std::string& pref_name) {
+  auto it = storages_.find(pref_name);
+  if (it != storages_.end())
+    return it->second.get();
+
+  it = storages_.emplace(pref_name, nullptr).first;
+  // The map key outlives the storage, so it can hold on to its c_str().
+  it->second = std::make_unique<WeeklyStorage>(prefs_, it->first.c_str());
+  it->second->SetDeferredSaveCallback(base::BindRepeating(
+      &WeeklyStorageRegistry::OnStorageChanged, base::Unretained(this)));
+  return it->second.get();
+}
+
+void WeeklyStorageRegistry::Flush() {
+  save_timer_.Stop();
+  for (auto& storage : storages_)
+    storage.second->SaveIfNeeded();
+}
+
+void WeeklyStorageRegistry::OnStorageChanged() {
+  if (save_timer_.IsRunning())
+    return;
+  save_timer_.Start(FROM_HERE, kSaveDelay, this, &WeeklyStorageRegistry::Flush);
+}
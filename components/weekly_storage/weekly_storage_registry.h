@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/timer/timer.h"
+
+class PrefService;
+class WeeklyStorage;
+
+// Keeps the |WeeklyStorage| of each pref of |prefs| in memory, so recording
+// a value doesn't parse and rewrite the pref list every time. Changes are
+// written to |prefs| in batches and when the registry is flushed or
+// destroyed, which must happen before |prefs| is destroyed.
+// There should be a single registry per |prefs| recording a given pref,
+// otherwise the in-memory copies get out of sync.
+class WeeklyStorageRegistry {
+ public:
+  explicit WeeklyStorageRegistry(PrefService* prefs);
+  ~WeeklyStorageRegistry();
+
+  WeeklyStorageRegistry(const WeeklyStorageRegistry&) = delete;
+  WeeklyStorageRegistry& operator=(const WeeklyStorageRegistry&) = delete;
+
+  // Returns the storage for |pref_name|, loading it on first use. Requires
+  // |pref_name| to be already registered.
+  WeeklyStorage* Get(const std::string& pref_name);
+
+  // Writes all pending changes to |prefs|.
+  void Flush();
+
+  PrefService* prefs() const { return prefs_; }
+
+ private:
+  void OnStorageChanged();
+
+  PrefService* prefs_ = nullptr;  // NOT OWNED
+  std::map<std::string, std::unique_ptr<WeeklyStorage>> storages_;
+  base::OneShotTimer save_timer_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
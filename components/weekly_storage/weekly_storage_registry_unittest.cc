@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include <memory>
+
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+constexpr char kPrefName[] = "brave.weekly_registry_test";
+}  // namespace
+
+class WeeklyStorageRegistryTest : public ::testing::Test {
+ public:
+  WeeklyStorageRegistryTest() {
+    pref_service_.registry()->RegisterListPref(kPrefName);
+    registry_ = std::make_unique<WeeklyStorageRegistry>(&pref_service_);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<WeeklyStorageRegistry> registry_;
+};
+
+TEST_F(WeeklyStorageRegistryTest, ReturnsSameStorage) {
+  EXPECT_EQ(registry_->Get(kPrefName), registry_->Get(kPrefName));
+}
+
+TEST_F(WeeklyStorageRegistryTest, SavesInBatches) {
+  registry_->Get(kPrefName)->AddDelta(1);
+  registry_->Get(kPrefName)->AddDelta(2);
+  EXPECT_EQ(registry_->Get(kPrefName)->GetWeeklySum(), 3ULL);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(WeeklyStorage(&pref_service_, kPrefName).GetWeeklySum(), 3ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, SavesOnDestruction) {
+  registry_->Get(kPrefName)->AddDelta(5);
+  registry_.reset();
+  EXPECT_EQ(WeeklyStorage(&pref_service_, kPrefName).GetWeeklySum(), 5ULL);
+}